@@ -1,8 +1,20 @@
+#define _GNU_SOURCE // syscall() em <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <time.h>
 
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
 #define MAX 10000
+#define BLOCO_INSERCAO 100  // Inserções medidas juntas em cada linha de insercao.csv
+#define LINHAS_INSERCAO 50
 
 // ======================== FILA DE PRIORIDADE SEM HEAP (LISTA ORDENADA) ==========================
 
@@ -105,32 +117,459 @@ int removerHeap(HEAP* h) {
     return raiz;
 }
 
+// ======================== POOL DE NÓS (SLAB + LISTA LIVRE) ==========================
+// Os nós da pairing heap saem de blocos grandes alocados de uma vez só; um nó removido
+// volta para a lista livre e é reaproveitado na próxima inserção, sem malloc/free por elemento.
+
+#define NOS_POR_BLOCO 1024
+
+typedef struct nopar{
+    int valor;
+    struct nopar *filho;   // primeiro filho
+    struct nopar *irmao;   // próximo irmão (também usado como "prox" na lista livre)
+}NOPAR;
+
+typedef struct bloco{
+    NOPAR nos[NOS_POR_BLOCO];
+    struct bloco *prox;
+}BLOCO;
+
+typedef struct{
+    BLOCO *blocos;   // lista de blocos alocados
+    int usados;      // nós já entregues do bloco atual
+    NOPAR *livres;   // nós devolvidos
+}POOL;
+
+POOL *criarPool(){
+    POOL *pool = malloc(sizeof(POOL));
+    pool->blocos = NULL;
+    pool->usados = NOS_POR_BLOCO;
+    pool->livres = NULL;
+    return pool;
+}
+
+NOPAR *alocarNo(POOL *pool){
+    if (pool->livres){
+        NOPAR *no = pool->livres;
+        pool->livres = no->irmao;
+        return no;
+    }
+    if (pool->usados == NOS_POR_BLOCO){
+        BLOCO *novo = malloc(sizeof(BLOCO));
+        novo->prox = pool->blocos;
+        pool->blocos = novo;
+        pool->usados = 0;
+    }
+    return &pool->blocos->nos[pool->usados++];
+}
+
+void liberarNo(POOL *pool, NOPAR *no){
+    no->irmao = pool->livres;
+    pool->livres = no;
+}
+
+void destruirPool(POOL *pool){
+    while (pool->blocos){
+        BLOCO *aux = pool->blocos;
+        pool->blocos = aux->prox;
+        free(aux);
+    }
+    free(pool);
+}
+
+// ======================== FILA DE PRIORIDADE COM PAIRING HEAP ==========================
+// Heap de máximo baseada em ponteiros: inserir e unir (meld) são O(1);
+// remover é O(log n) amortizado com o pareamento em duas passadas.
+
+typedef struct{
+    NOPAR *raiz;
+    POOL *pool;     // várias filas podem dividir o mesmo pool, o que permite unir sem copiar
+    int tamanho;
+    int comparacoes;
+}PAIRING;
+
+PAIRING *criarPairing(POOL *pool){
+    PAIRING *fila = malloc(sizeof(PAIRING));
+    fila->raiz = NULL;
+    fila->pool = pool;
+    fila->tamanho = 0;
+    fila->comparacoes = 0;
+    return fila;
+}
+
+// Une duas árvores: a de menor raiz vira o primeiro filho da outra
+NOPAR *unirArvores(PAIRING *fila, NOPAR *a, NOPAR *b){
+    if (!a) return b;
+    if (!b) return a;
+    fila->comparacoes++;
+    if (b->valor > a->valor){
+        NOPAR *aux = a;
+        a = b;
+        b = aux;
+    }
+    b->irmao = a->filho;
+    a->filho = b;
+    a->irmao = NULL;
+    return a;
+}
+
+void inserirPairing(PAIRING *fila, int valor){
+    NOPAR *novo = alocarNo(fila->pool);
+    novo->valor = valor;
+    novo->filho = NULL;
+    novo->irmao = NULL;
+    fila->raiz = unirArvores(fila, fila->raiz, novo);
+    fila->tamanho++;
+}
+
+// Junta a fila b dentro da fila a em O(1); b fica vazia
+void unirPairing(PAIRING *a, PAIRING *b){
+    a->raiz = unirArvores(a, a->raiz, b->raiz);
+    a->tamanho += b->tamanho;
+    a->comparacoes += b->comparacoes;
+    b->raiz = NULL;
+    b->tamanho = 0;
+}
+
+// Pareamento em duas passadas: da esquerda para a direita une os filhos dois a dois,
+// depois une os pares da direita para a esquerda (a lista de pares é mantida invertida)
+NOPAR *parearFilhos(PAIRING *fila, NOPAR *primeiro){
+    NOPAR *pares = NULL;
+    while (primeiro){
+        NOPAR *a = primeiro;
+        NOPAR *b = a->irmao;
+        if (!b){
+            a->irmao = pares;
+            pares = a;
+            break;
+        }
+        primeiro = b->irmao;
+        a->irmao = NULL;
+        b->irmao = NULL;
+        NOPAR *par = unirArvores(fila, a, b);
+        par->irmao = pares;
+        pares = par;
+    }
+
+    NOPAR *resultado = NULL;
+    while (pares){
+        NOPAR *prox = pares->irmao;
+        pares->irmao = NULL;
+        resultado = unirArvores(fila, resultado, pares);
+        pares = prox;
+    }
+    return resultado;
+}
+
+int removerPairing(PAIRING *fila){
+    if (!fila->raiz) return -1;
+    NOPAR *raiz = fila->raiz;
+    int val = raiz->valor;
+    fila->raiz = parearFilhos(fila, raiz->filho);
+    fila->tamanho--;
+    liberarNo(fila->pool, raiz);
+    return val;
+}
+
+// ======================== UNIÃO DE FILAS (PARA COMPARAÇÃO) ==========================
+
+// Lista ordenada: intercala as duas listas, O(n + m)
+void unirLista(FILA *a, FILA *b){
+    NO *inicio = NULL;
+    NO **p = &inicio;
+    while (a->inicio && b->inicio){
+        a->comparacoes++;
+        NO **maior = (a->inicio->valor >= b->inicio->valor) ? &a->inicio : &b->inicio;
+        *p = *maior;
+        *maior = (*maior)->prox;
+        p = &(*p)->prox;
+    }
+    *p = a->inicio ? a->inicio : b->inicio;
+    a->inicio = inicio;
+    a->comparacoes += b->comparacoes;
+    b->inicio = NULL;
+}
+
+// Heap em vetor: concatena e reconstrói de baixo para cima, O(n + m)
+void unirHeap(HEAP *a, HEAP *b){
+    for (int i = 0; i < b->tamanho; i++){
+        a->dados[a->tamanho++] = b->dados[i];
+    }
+    for (int i = a->tamanho / 2 - 1; i >= 0; i--){
+        descer(a, i);
+    }
+    a->comparacoes += b->comparacoes;
+    b->tamanho = 0;
+}
+
+// ======================== CONTADORES DE HARDWARE (perf_event_open) ==========================
+// Cada região medida é cercada por medirInicio/medirFim e os valores vão sendo acumulados,
+// igual ao contador de comparações. Uma região precisa de muitas operações: medir uma inserção
+// sozinha mediria mais os ioctl e o read do grupo do que a inserção. Se o kernel não deixar abrir um contador (fora do Linux,
+// perf_event_paranoid alto, máquina virtual sem PMU...) ele fica indisponível e a coluna sai vazia.
+// Os contadores abertos formam um grupo: o primeiro é o líder e os outros só contam junto com ele,
+// então todos medem exatamente o mesmo intervalo. Se o kernel multiplexar a PMU, o valor lido é
+// escalado por tempo_habilitado / tempo_rodando.
+
+#define NUM_CONTADORES 5
+
+const char *nomesContadores[NUM_CONTADORES] = {"Ciclos", "Instrucoes", "FalhasL1", "FalhasLLC", "FalhasDesvio"};
+
+typedef struct{
+    int fd[NUM_CONTADORES];            // -1 quando o contador não está disponível
+    int lider;                         // fd do líder do grupo (-1 se nenhum abriu)
+    uint64_t valores[NUM_CONTADORES];  // acumulado de todas as regiões medidas
+}CONTADORES;
+
+#ifdef __linux__
+// lider = -1 abre o líder (desligado); os membros seguem o líder e começam ligados
+int abrirContador(uint32_t tipo, uint64_t config, int lider){
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = tipo;
+    attr.config = config;
+    attr.disabled = lider < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, lider, 0);
+}
+#endif
+
+void iniciarContadores(CONTADORES *c){
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        c->fd[i] = -1;
+        c->valores[i] = 0;
+    }
+    c->lider = -1;
+#ifdef __linux__
+    uint32_t tipos[NUM_CONTADORES] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                      PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+    uint64_t configs[NUM_CONTADORES] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    // O primeiro que abrir vira o líder; os valores do grupo chegam na ordem de abertura
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        c->fd[i] = abrirContador(tipos[i], configs[i], c->lider);
+        if (c->fd[i] >= 0 && c->lider < 0) c->lider = c->fd[i];
+    }
+#endif
+}
+
+int contadoresDisponiveis(CONTADORES *c){
+    int total = 0;
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        if (c->fd[i] >= 0) total++;
+    }
+    return total;
+}
+
+// Lista os contadores que não abriram, ex.: "Aviso: contadores indisponiveis para SemHeap: FalhasL1"
+void avisarContadores(CONTADORES *c, const char *nome){
+    if (contadoresDisponiveis(c) == NUM_CONTADORES) return;
+    printf("Aviso: contadores de hardware indisponiveis para %s (colunas vazias):", nome);
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        if (c->fd[i] < 0) printf(" %s", nomesContadores[i]);
+    }
+    printf("\n");
+}
+
+void medirInicio(CONTADORES *c){
+#ifdef __linux__
+    if (c->lider < 0) return;
+    ioctl(c->lider, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(c->lider, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    (void) c;
+#endif
+}
+
+void medirFim(CONTADORES *c){
+#ifdef __linux__
+    if (c->lider < 0) return;
+    ioctl(c->lider, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Leitura do grupo: {quantidade, tempo_habilitado, tempo_rodando, valor de cada membro}
+    uint64_t dados[3 + NUM_CONTADORES];
+    int membros = contadoresDisponiveis(c);
+    ssize_t esperado = (ssize_t) ((3 + membros) * sizeof(uint64_t));
+    if (read(c->lider, dados, sizeof(dados)) != esperado || dados[0] != (uint64_t) membros) return;
+    uint64_t habilitado = dados[1], rodando = dados[2];
+    if (rodando == 0) return;  // o grupo não chegou a ser agendado nesta região
+    int k = 3;
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        if (c->fd[i] < 0) continue;
+        c->valores[i] += (uint64_t) ((double) dados[k++] * habilitado / rodando);
+    }
+#else
+    (void) c;
+#endif
+}
+
+void zerarContadores(CONTADORES *c){
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        c->valores[i] = 0;
+    }
+}
+
+void fecharContadores(CONTADORES *c){
+#ifdef __linux__
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        if (c->fd[i] >= 0) close(c->fd[i]);
+        c->fd[i] = -1;
+    }
+#endif
+}
+
+// Escreve os nomes das colunas, ex.: ",SemHeapCiclos,SemHeapInstrucoes,..."
+void cabecalhoContadores(FILE *f, const char *prefixo){
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        fprintf(f, ",%s%s", prefixo, nomesContadores[i]);
+    }
+}
+
+// Escreve os valores; contador indisponível vira campo vazio (NaN no readtable)
+void escreverContadores(FILE *f, CONTADORES *c){
+    for (int i = 0; i < NUM_CONTADORES; i++){
+        if (c->fd[i] >= 0) fprintf(f, ",%llu", (unsigned long long) c->valores[i]);
+        else fprintf(f, ",");
+    }
+}
+
 // ======================== MAIN ==========================
 
 int main() {
     srand(time(NULL));
     FILA* filaLista = criarFilaLista();
     HEAP* heap = criarHEAP(MAX);
+    POOL* pool = criarPool();
+    PAIRING* pairing = criarPairing(pool);
+
+    // Um conjunto de contadores por estrutura
+    CONTADORES cLista, cHeap, cPairing;
+    iniciarContadores(&cLista);
+    iniciarContadores(&cHeap);
+    iniciarContadores(&cPairing);
+    avisarContadores(&cLista, "SemHeap");
+    avisarContadores(&cHeap, "ComHeap");
+    avisarContadores(&cPairing, "Pairing");
 
     FILE* f_insercao = fopen("insercao.csv", "w");
+    FILE* f_uniao = fopen("uniao.csv", "w");
 
-    if (!f_insercao) {
+    if (!f_insercao || !f_uniao) {
         printf("Erro ao abrir os arquivos!\n");
         return 1;
     }
 
-    fprintf(f_insercao, "Tamanho,SemHeap,ComHeap\n");
+    fprintf(f_insercao, "Tamanho,SemHeap,ComHeap,Pairing");
+    cabecalhoContadores(f_insercao, "SemHeap");
+    cabecalhoContadores(f_insercao, "ComHeap");
+    cabecalhoContadores(f_insercao, "Pairing");
+    fprintf(f_insercao, "\n");
+
+    // Insere LINHAS_INSERCAO blocos de BLOCO_INSERCAO elementos, cada bloco numa região medida;
+    // comparações e contadores saem acumulados desde o início, então as colunas são comparáveis
+    int bloco[BLOCO_INSERCAO];
+    for (int linha = 1; linha <= LINHAS_INSERCAO; linha++) {
+        for (int i = 0; i < BLOCO_INSERCAO; i++) {
+            bloco[i] = rand() % 10000;
+        }
+
+        medirInicio(&cLista);
+        for (int i = 0; i < BLOCO_INSERCAO; i++) inserirLista(filaLista, bloco[i]);
+        medirFim(&cLista);
+
+        medirInicio(&cHeap);
+        for (int i = 0; i < BLOCO_INSERCAO; i++) inserirHeap(heap, bloco[i]);
+        medirFim(&cHeap);
+
+        medirInicio(&cPairing);
+        for (int i = 0; i < BLOCO_INSERCAO; i++) inserirPairing(pairing, bloco[i]);
+        medirFim(&cPairing);
+
+        fprintf(f_insercao, "%d,%d,%d,%d", linha * BLOCO_INSERCAO, filaLista->comparacoes, heap->comparacoes,
+                pairing->comparacoes);
+        escreverContadores(f_insercao, &cLista);
+        escreverContadores(f_insercao, &cHeap);
+        escreverContadores(f_insercao, &cPairing);
+        fprintf(f_insercao, "\n");
+    }
+
+    // União: duas filas de tamanho n cada, mede comparações e tempo de unir
+    fprintf(f_uniao, "Tamanho,SemHeap,ComHeap,Pairing,TempoSemHeap,TempoComHeap,TempoPairing");
+    cabecalhoContadores(f_uniao, "SemHeap");
+    cabecalhoContadores(f_uniao, "ComHeap");
+    cabecalhoContadores(f_uniao, "Pairing");
+    fprintf(f_uniao, "\n");
+    for (int n = 500; n <= MAX / 2; n += 500) {
+        FILA *la = criarFilaLista(), *lb = criarFilaLista();
+        HEAP *ha = criarHEAP(2 * n), *hb = criarHEAP(n);
+        PAIRING *pa = criarPairing(pool), *pb = criarPairing(pool);
 
-    // Inserir 500 elementos
-    for (int i = 0; i < 50; i++) {
-        int val = rand() % 10000;
-        inserirLista(filaLista, val);
-        inserirHeap(heap, val);
-        fprintf(f_insercao, "%d,%d,%d\n", i, filaLista->comparacoes, heap->comparacoes);
+        for (int i = 0; i < n; i++) {
+            int v1 = rand() % 10000, v2 = rand() % 10000;
+            inserirLista(la, v1); inserirLista(lb, v2);
+            inserirHeap(ha, v1); inserirHeap(hb, v2);
+            inserirPairing(pa, v1); inserirPairing(pb, v2);
+        }
+        la->comparacoes = lb->comparacoes = 0;
+        ha->comparacoes = hb->comparacoes = 0;
+        pa->comparacoes = pb->comparacoes = 0;
+        zerarContadores(&cLista);
+        zerarContadores(&cHeap);
+        zerarContadores(&cPairing);
+
+        clock_t t0 = clock();
+        medirInicio(&cLista);
+        unirLista(la, lb);
+        medirFim(&cLista);
+        clock_t t1 = clock();
+        medirInicio(&cHeap);
+        unirHeap(ha, hb);
+        medirFim(&cHeap);
+        clock_t t2 = clock();
+        medirInicio(&cPairing);
+        unirPairing(pa, pb);
+        medirFim(&cPairing);
+        clock_t t3 = clock();
+
+        fprintf(f_uniao, "%d,%d,%d,%d,%f,%f,%f", n, la->comparacoes, ha->comparacoes, pa->comparacoes,
+                (double)(t1 - t0) / CLOCKS_PER_SEC, (double)(t2 - t1) / CLOCKS_PER_SEC,
+                (double)(t3 - t2) / CLOCKS_PER_SEC);
+        escreverContadores(f_uniao, &cLista);
+        escreverContadores(f_uniao, &cHeap);
+        escreverContadores(f_uniao, &cPairing);
+        fprintf(f_uniao, "\n");
+
+        // Esvazia as filas para conferir a ordem e devolver os nós ao pool
+        int anterior = 10000;
+        while (pa->tamanho > 0) {
+            int v = removerPairing(pa);
+            if (v > anterior) printf("Erro: pairing heap fora de ordem!\n");
+            anterior = v;
+        }
+        while (la->inicio) removerLista(la);
+        free(la); free(lb);
+        free(ha->dados); free(ha); free(hb->dados); free(hb);
+        free(pa); free(pb);
     }
 
     fclose(f_insercao);
+    fclose(f_uniao);
+    fecharContadores(&cLista);
+    fecharContadores(&cHeap);
+    fecharContadores(&cPairing);
+
+    while (filaLista->inicio) removerLista(filaLista);
+    free(filaLista);
+    free(heap->dados);
+    free(heap);
+    free(pairing);
+    destruirPool(pool);
 
-    printf("Arquivo insercao.csv gerado!\n");
+    printf("Arquivos insercao.csv e uniao.csv gerados!\n");
     return 0;
 }
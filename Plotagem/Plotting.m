@@ -5,12 +5,20 @@ dados = readtable('resultados.csv');
 tamanho = dados.Tamanho;
 semHeap = dados.SemHeap;
 comHeap = dados.ComHeap;
+% A coluna Pairing só existe nos CSVs gerados a partir da pairing heap
+temPairing = ismember('Pairing', dados.Properties.VariableNames);
+if temPairing
+    pairing = dados.Pairing;
+end
 
 % Cria o gráfico
 figure;
 plot(tamanho, semHeap, '-o', 'LineWidth', 2, 'DisplayName', 'Fila sem HEAP');
 hold on;
 plot(tamanho, comHeap, '-s', 'LineWidth', 2, 'DisplayName', 'Fila com HEAP');
+if temPairing
+    plot(tamanho, pairing, '-^', 'LineWidth', 2, 'DisplayName', 'Pairing heap');
+end
 hold off;
 
 % Personalização do gráfico
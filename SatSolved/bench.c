@@ -0,0 +1,467 @@
+// Benchmark do solver: famílias geradas em tamanhos crescentes e arquivos DIMACS de uma pasta.
+// Cada instância roda num processo filho, para medir o pico de memória dela sozinha e poder
+// cortar pelo tempo sem perder o resto da bateria.
+//
+// O solver é usado só pela interface de sat.h, como qualquer programa que ligue com a biblioteca,
+// então a busca recebe as cláusulas como estão (o pré-processamento é coisa do main de sat.c).
+//
+// Compilar com: gcc -O2 -pthread -DSAT_BIBLIOTECA bench.c sat.c -o bench
+// Uso: ./bench [--saida=bench.csv] [--pasta=DIR] [--tempo=S] [--semente=S] [--sem-geradas]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <time.h>
+#include <dirent.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "sat.h"
+
+#define RAZAO_3SAT 4.26   // Transição de fase do 3-SAT aleatório
+#define GRAU_COLORACAO 4.6 // Grau médio perto do limiar da 3-coloração
+#define SEMENTES 3        // Instâncias aleatórias por tamanho
+
+//------ Gerador pseudoaleatório próprio: as instâncias não dependem da libc --------
+uint64_t estado_bench;
+
+uint64_t sorteio (void){
+    estado_bench ^= estado_bench << 13;
+    estado_bench ^= estado_bench >> 7;
+    estado_bench ^= estado_bench << 17;
+    return estado_bench;
+}
+
+//------ Instância em memória: literais no formato DIMACS, cada cláusula terminada em 0 --------
+typedef struct instancia{
+    int *lits;
+    int tam, cap;
+    int num_variaveis, num_clausulas;
+}instancia;
+
+void iniciar_instancia (instancia *I){
+    I->lits = NULL;
+    I->tam = I->cap = 0;
+    I->num_variaveis = I->num_clausulas = 0;
+}
+
+void liberar_instancia (instancia *I){
+    free(I->lits);
+}
+
+void add_lit (instancia *I, int lit){ // lit = 0 fecha a cláusula
+    if (I->tam == I->cap){
+        I->cap = I->cap ? 2 * I->cap : 1024;
+        I->lits = (int*)realloc(I->lits, I->cap * sizeof(int));
+    }
+    I->lits[I->tam++] = lit;
+    if (lit == 0){
+        I->num_clausulas++;
+    }
+    else if (abs(lit) > I->num_variaveis){
+        I->num_variaveis = abs(lit);
+    }
+}
+
+void clausula (instancia *I, int a, int b, int c){ // Até 3 literais; 0 = ausente
+    if (a) add_lit(I, a);
+    if (b) add_lit(I, b);
+    if (c) add_lit(I, c);
+    add_lit(I, 0);
+}
+
+void fechar_instancia (instancia *I, int num_variaveis){ // Conta também as variáveis que não apareceram
+    if (num_variaveis > I->num_variaveis){
+        I->num_variaveis = num_variaveis;
+    }
+}
+
+//=================== FAMÍLIAS DE INSTÂNCIAS ===================
+
+//------ 3-SAT aleatório com n variáveis e razão cláusulas/variáveis na transição --------
+void gerar_3sat (instancia *I, int n){
+    iniciar_instancia(I);
+    int m = (int)(RAZAO_3SAT * n + 0.5);
+    for (int c = 0; c < m; c++){
+        int x[3];
+        for (int k = 0; k < 3; k++){
+            bool repetida;
+            do { // Três variáveis distintas por cláusula
+                x[k] = (int)(sorteio() % n) + 1;
+                repetida = false;
+                for (int j = 0; j < k; j++){
+                    repetida |= (x[j] == x[k]);
+                }
+            } while (repetida);
+            if (sorteio() & 1){
+                x[k] = -x[k];
+            }
+        }
+        clausula(I, x[0], x[1], x[2]);
+    }
+    fechar_instancia(I, n);
+}
+
+//------ Casa dos pombos: n + 1 pombos em n buracos (sempre UNSAT) --------
+void gerar_pombos (instancia *I, int n){
+    iniciar_instancia(I);
+    #define POMBO(p, b) ((p) * n + (b) + 1)
+    for (int p = 0; p <= n; p++){ // Todo pombo em algum buraco
+        for (int b = 0; b < n; b++){
+            add_lit(I, POMBO(p, b));
+        }
+        add_lit(I, 0);
+    }
+    for (int b = 0; b < n; b++){ // Nenhum buraco com dois pombos
+        for (int p = 0; p <= n; p++){
+            for (int q = p + 1; q <= n; q++){
+                clausula(I, -POMBO(p, b), -POMBO(q, b), 0);
+            }
+        }
+    }
+    #undef POMBO
+    fechar_instancia(I, (n + 1) * n);
+}
+
+//------ s = a XOR b em 4 cláusulas --------
+void xor3 (instancia *I, int s, int a, int b){
+    clausula(I, -s, a, b);
+    clausula(I, -s, -a, -b);
+    clausula(I, s, -a, b);
+    clausula(I, s, a, -b);
+}
+
+//------ Paridade: a mesma soma XOR de n bits calculada em duas ordens, com resultados opostos --------
+// Sempre UNSAT, mas o CDCL só descobre isso somando as duas cadeias.
+void gerar_paridade (instancia *I, int n){
+    iniciar_instancia(I);
+    int *ordem = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++){
+        ordem[i] = i + 1;
+    }
+    for (int i = n - 1; i > 0; i--){
+        int j = (int)(sorteio() % (i + 1));
+        int t = ordem[i]; ordem[i] = ordem[j]; ordem[j] = t;
+    }
+    int prox = n + 1;
+    for (int cadeia = 0; cadeia < 2; cadeia++){
+        int acumulado = cadeia ? ordem[0] : 1;
+        for (int i = 1; i < n; i++){
+            int s = prox++;
+            xor3(I, s, acumulado, cadeia ? ordem[i] : i + 1);
+            acumulado = s;
+        }
+        clausula(I, cadeia ? -acumulado : acumulado, 0, 0);
+    }
+    free(ordem);
+    fechar_instancia(I, prox - 1);
+}
+
+//------ 3-coloração de um grafo aleatório com n vértices --------
+void gerar_coloracao (instancia *I, int n){
+    iniciar_instancia(I);
+    #define COR(v, c) (3 * (v) + (c) + 1)
+    for (int v = 0; v < n; v++){
+        clausula(I, COR(v, 0), COR(v, 1), COR(v, 2));
+        for (int c = 0; c < 3; c++){
+            for (int d = c + 1; d < 3; d++){
+                clausula(I, -COR(v, c), -COR(v, d), 0);
+            }
+        }
+    }
+    int arestas = (int)(GRAU_COLORACAO * n / 2);
+    for (int e = 0; e < arestas; e++){
+        int u = (int)(sorteio() % n), v = (int)(sorteio() % n);
+        if (u == v){
+            continue;
+        }
+        for (int c = 0; c < 3; c++){
+            clausula(I, -COR(u, c), -COR(v, c), 0);
+        }
+    }
+    #undef COR
+    fechar_instancia(I, 3 * n);
+}
+
+typedef struct familia{
+    const char *nome;
+    void (*gerar)(instancia*, int);
+    int tamanhos[8]; // Termina no 0
+    bool aleatoria;  // Repete com SEMENTES sementes
+}familia;
+
+familia familias[] = {
+    {"3sat", gerar_3sat, {50, 100, 150, 200, 250, 300, 0}, true},
+    {"pombos", gerar_pombos, {5, 6, 7, 8, 9, 0}, false},
+    {"paridade", gerar_paridade, {8, 12, 16, 20, 24, 28, 0}, true},
+    {"coloracao", gerar_coloracao, {50, 100, 200, 400, 600, 0}, true},
+};
+
+//=================== EXECUÇÃO E MEDIÇÃO ===================
+
+typedef struct medida{
+    int resultado; // RES_SAT, RES_UNSAT ou RES_DESCONHECIDO (modelo errado / sem resposta)
+    long decisoes, propagacoes, conflitos;
+}medida;
+
+double agora (void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//------ Confere o modelo do solver contra todas as cláusulas da instância --------
+bool modelo_confere (solver *S, instancia *I){
+    bool satisfeita = false;
+    for (int i = 0; i < I->tam; i++){
+        if (I->lits[i] == 0){
+            if (!satisfeita){
+                return false;
+            }
+            satisfeita = false;
+        }
+        else if (sat_valor(S, I->lits[i]) == 1){
+            satisfeita = true;
+        }
+    }
+    return true;
+}
+
+//------ Roda no filho: entrega as cláusulas ao solver, resolve e confere o modelo --------
+medida resolver_instancia (instancia *I){
+    medida m = {RES_DESCONHECIDO, 0, 0, 0};
+    solver *S = sat_novo();
+    int inicio = 0;
+    for (int i = 0; i < I->tam; i++){
+        if (I->lits[i] == 0){
+            sat_adicionar(S, &I->lits[inicio], i - inicio); // false (já insatisfatível) sai no resolver
+            inicio = i + 1;
+        }
+    }
+    m.resultado = sat_resolver(S, NULL, 0, -1);
+    if (m.resultado == RES_SAT && !modelo_confere(S, I)){
+        m.resultado = RES_DESCONHECIDO;
+    }
+    sat_estatisticas(S, &m.decisoes, &m.propagacoes, &m.conflitos);
+    sat_liberar(S);
+    return m;
+}
+
+//------ Mede uma instância num processo separado e escreve a linha do CSV --------
+void medir (FILE *csv, const char *fam, const char *nome, instancia *I, int tempo){
+    int canal[2];
+    if (pipe(canal) != 0){
+        perror("pipe");
+        return;
+    }
+    fflush(stdout);
+    double inicio = agora();
+    pid_t filho = fork();
+    if (filho < 0){
+        perror("fork");
+        close(canal[0]); close(canal[1]);
+        return;
+    }
+    if (filho == 0){
+        close(canal[0]);
+        alarm(tempo); // Estourou o tempo: o filho morre e a linha sai como TEMPO
+        medida m = resolver_instancia(I);
+        if (write(canal[1], &m, sizeof(m)) != sizeof(m)){
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(canal[1]);
+    medida m;
+    bool recebida = (read(canal[0], &m, sizeof(m)) == sizeof(m));
+    close(canal[0]);
+    int status;
+    struct rusage uso;
+    wait4(filho, &status, 0, &uso);
+    double tempo_gasto = agora() - inicio;
+
+    const char *resultado;
+    if (!recebida){
+        resultado = (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) ? "TEMPO" : "FALHA";
+        m.decisoes = m.propagacoes = m.conflitos = 0;
+    }
+    else {
+        resultado = (m.resultado == RES_SAT) ? "SAT" : (m.resultado == RES_UNSAT) ? "UNSAT" : "ERRO";
+    }
+    // ru_maxrss vem em KiB no Linux; como é um processo por instância, é o pico só dela
+    fprintf(csv, "%s,%s,%d,%d,%s,%.4f,%ld,%.0f,%ld,%ld\n", fam, nome, I->num_variaveis, I->num_clausulas,
+            resultado, tempo_gasto, m.decisoes, m.propagacoes / (tempo_gasto > 0 ? tempo_gasto : 1),
+            m.conflitos, uso.ru_maxrss);
+    fflush(csv);
+    printf("%-10s %-28s %-6s %8.3fs %10ld conflitos %8ld KiB\n", fam, nome, resultado, tempo_gasto,
+           m.conflitos, uso.ru_maxrss);
+}
+
+void rodar_geradas (FILE *csv, uint64_t semente, int tempo){
+    for (size_t f = 0; f < sizeof(familias) / sizeof(familias[0]); f++){
+        familia *fam = &familias[f];
+        for (int t = 0; fam->tamanhos[t] != 0; t++){
+            int repeticoes = fam->aleatoria ? SEMENTES : 1;
+            for (int r = 0; r < repeticoes; r++){
+                estado_bench = semente * 0x9E3779B97F4A7C15ULL + 1000003ULL * fam->tamanhos[t] + r + 1;
+                instancia I;
+                fam->gerar(&I, fam->tamanhos[t]);
+                char nome[64];
+                snprintf(nome, sizeof(nome), "%s-%d-s%d", fam->nome, fam->tamanhos[t], r);
+                medir(csv, fam->nome, nome, &I, tempo);
+                liberar_instancia(&I);
+            }
+        }
+    }
+}
+
+//------ Abre o .cnf, passando pelo gzip se for .cnf.gz --------
+FILE *abrir_arquivo (const char *caminho, bool *via_pipe){
+    size_t n = strlen(caminho);
+    *via_pipe = (n > 3 && strcmp(caminho + n - 3, ".gz") == 0);
+    if (!*via_pipe){
+        return fopen(caminho, "r");
+    }
+    // Monta: gzip -dc '<caminho>' (aspas simples escapadas)
+    char *cmd = (char*)malloc(4 * n + 32);
+    char *p = cmd + sprintf(cmd, "gzip -dc '");
+    for (const char *s = caminho; *s; s++){
+        if (*s == '\''){
+            p += sprintf(p, "'\\''");
+        }
+        else {
+            *p++ = *s;
+        }
+    }
+    strcpy(p, "'");
+    FILE *fp = popen(cmd, "r");
+    free(cmd);
+    return fp;
+}
+
+//------ Lê um DIMACS para a instância; a carga fica fora da medida, então basta o fscanf --------
+bool ler_instancia (FILE *fp, instancia *I){
+    iniciar_instancia(I);
+    int ch, abertos = 0; // Literais da cláusula aberta
+    while ((ch = getc(fp)) != EOF && ch != '%'){ // Alguns arquivos do SATLIB terminam com "%"
+        if (ch == 'c' || ch == 'p'){
+            int v;
+            if (ch == 'p' && fscanf(fp, " cnf %d", &v) == 1){
+                fechar_instancia(I, v);
+            }
+            while (ch != EOF && ch != '\n'){
+                ch = getc(fp);
+            }
+            continue;
+        }
+        if (isspace(ch)){
+            continue;
+        }
+        ungetc(ch, fp);
+        int lit;
+        if (fscanf(fp, "%d", &lit) != 1){
+            return false;
+        }
+        add_lit(I, lit);
+        abertos = (lit == 0) ? 0 : abertos + 1;
+    }
+    if (abertos > 0){ // Última cláusula sem o 0 final
+        add_lit(I, 0);
+    }
+    return true;
+}
+
+int comparar_nomes (const void *a, const void *b){
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+//------ Todos os .cnf e .cnf.gz da pasta, em ordem alfabética --------
+void rodar_pasta (FILE *csv, const char *pasta, int tempo){
+    DIR *d = opendir(pasta);
+    if (d == NULL){
+        printf("Erro ao abrir a pasta %s.\n", pasta);
+        return;
+    }
+    char **nomes = NULL;
+    int num = 0, cap = 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL){
+        size_t tam = strlen(e->d_name);
+        bool cnf = (tam > 4 && strcmp(e->d_name + tam - 4, ".cnf") == 0) ||
+                   (tam > 7 && strcmp(e->d_name + tam - 7, ".cnf.gz") == 0);
+        if (!cnf){
+            continue;
+        }
+        if (num == cap){
+            cap = cap ? 2 * cap : 16;
+            nomes = (char**)realloc(nomes, cap * sizeof(char*));
+        }
+        nomes[num++] = strdup(e->d_name);
+    }
+    closedir(d);
+    qsort(nomes, num, sizeof(char*), comparar_nomes);
+    for (int i = 0; i < num; i++){
+        char caminho[4096];
+        snprintf(caminho, sizeof(caminho), "%s/%s", pasta, nomes[i]);
+        bool via_pipe;
+        FILE *fp = abrir_arquivo(caminho, &via_pipe);
+        instancia I;
+        bool lido = (fp != NULL) && ler_instancia(fp, &I);
+        if (fp != NULL){
+            via_pipe ? pclose(fp) : fclose(fp);
+        }
+        if (lido){
+            medir(csv, "arquivo", nomes[i], &I, tempo);
+        }
+        else {
+            printf("c %s ignorado (nao foi possivel ler)\n", nomes[i]);
+        }
+        if (fp != NULL){
+            liberar_instancia(&I);
+        }
+        free(nomes[i]);
+    }
+    free(nomes);
+}
+
+int main (int argc, char *argv[]){
+    const char *saida = "bench.csv";
+    const char *pasta = NULL;
+    int tempo = 60;
+    uint64_t semente = 1;
+    bool geradas = true;
+    for (int i = 1; i < argc; i++){
+        if (strncmp(argv[i], "--saida=", 8) == 0) saida = argv[i] + 8;
+        else if (strncmp(argv[i], "--pasta=", 8) == 0) pasta = argv[i] + 8;
+        else if (strncmp(argv[i], "--tempo=", 8) == 0 && atoi(argv[i] + 8) > 0) tempo = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--semente=", 10) == 0) semente = strtoull(argv[i] + 10, NULL, 10);
+        else if (strcmp(argv[i], "--sem-geradas") == 0) geradas = false;
+        else {
+            printf("Uso: %s [opcoes]\n", argv[0]);
+            printf("  --saida=ARQ         CSV de saida (padrao: bench.csv)\n");
+            printf("  --pasta=DIR         tambem roda os .cnf / .cnf.gz da pasta\n");
+            printf("  --tempo=S           limite por instancia em segundos (padrao: 60)\n");
+            printf("  --semente=S         semente das familias aleatorias (padrao: 1)\n");
+            printf("  --sem-geradas       so roda os arquivos da pasta\n");
+            return 1;
+        }
+    }
+    FILE *csv = fopen(saida, "w");
+    if (csv == NULL){
+        printf("Erro ao criar %s.\n", saida);
+        return 1;
+    }
+    fprintf(csv, "Familia,Instancia,Variaveis,Clausulas,Resultado,Tempo,Decisoes,PropagacoesPorSeg,Conflitos,MemoriaKB\n");
+    if (geradas){
+        rodar_geradas(csv, semente, tempo);
+    }
+    if (pasta != NULL){
+        rodar_pasta(csv, pasta, tempo);
+    }
+    fclose(csv);
+    return 0;
+}
@@ -2,129 +2,299 @@
 #include <string.h> 
 #include <stdlib.h>
 #include <stdbool.h> 
-#define MAX 100 
-
-//---------Árvore-----------
-typedef struct raiz{
-    int var ; // Varialvel
-    bool result ; // Resultado da interpretação parcial
-    struct raiz *direita; // Nó para a direita FALSE 
-    struct raiz *esquerda; // Nó para a esquerda TRUE
-}raiz;
-//----- Nos ------
-typedef struct No {
-    int item;
-    struct No *next;
-}No;
-//---- Clausulas -----
-typedef struct clausula{
-    No *literais; // Literias x1 , x2 ,x3 ..... e já vê se ele está negado
-    struct clausula *next; // Ponteiro para o próximo nó de literais
-}clausula;
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "sat.h"
+// Compilar com: gcc -O2 -pthread sat.c -o sat (com -mavx2 a avaliação exaustiva usa 256 bits por instrução)
+// Como biblioteca (interface em sat.h): gcc -O2 -pthread -DSAT_BIBLIOTECA -c sat.c
+
+#ifdef SAT_BIBLIOTECA
+#define SAT_INTERNO static __attribute__((unused)) // Só a interface sat_* fica visível; o que é da linha de comando sobra sem uso
+#else
+#define SAT_INTERNO
+#endif
+
+//---- Valores de uma interpretação parcial ------
+#define INDEFINIDO -1 // Variável ainda sem valor
+#define FALSO 0
+#define VERDADEIRO 1
+//---- Literais internos: a variável v (0..n-1) vira 2v (positivo) e 2v+1 (negado) ------
+#define LIT(x) ((x) > 0 ? 2 * ((x) - 1) : 2 * (-(x) - 1) + 1) // Converte do formato do arquivo
+#define VAR(l) ((l) >> 1)
+#define NEG(l) ((l) ^ 1)
+#define SINAL(l) ((l) & 1) // 1 se o literal é negado
+//---- Vetor dinâmico de inteiros ------
+typedef struct vetor{
+    int *dados;
+    int tam;
+    int cap;
+}vetor;
 //---- representação da formula ------
+// As cláusulas ficam num único vetor de literais (formato CSR): os literais da
+// cláusula i estão em literais[inicio[i]] ... literais[inicio[i + 1] - 1]
 typedef struct formula{
     int num_variaveis; // Número de variáveis 
     int num_setencas ; // Número de seteças
-    clausula *inicio ;    // lista de cláusulas
+    int num_clausulas; // Cláusulas lidas de fato
+    int *inicio;       // Posição da primeira literal de cada cláusula (num_clausulas + 1 posições)
+    int cap_inicio;
+    int *literais;     // Literais de todas as cláusulas, no formato do arquivo (x ou -x)
+    int num_literais;
+    int cap_literais;
 }formula;
 
-No *criar_lista_encadeada (){ // Inicializa a lista encadeada
-    return NULL;
+SAT_INTERNO void vetor_add (vetor *v, int x){
+    if (v->tam == v->cap){
+        v->cap = v->cap ? 2 * v->cap : 4;
+        v->dados = (int*)realloc(v->dados, v->cap * sizeof(int));
+    }
+    v->dados[v->tam++] = x;
+}
+
+SAT_INTERNO void iniciar_formula (formula *F){
+    F->num_variaveis = 0;
+    F->num_setencas = 0;
+    F->num_clausulas = 0;
+    F->cap_inicio = 16;
+    F->inicio = (int*)malloc(F->cap_inicio * sizeof(int));
+    F->inicio[0] = 0;
+    F->cap_literais = 64;
+    F->literais = (int*)malloc(F->cap_literais * sizeof(int));
+    F->num_literais = 0;
+}
+//------Adiciona um literal à cláusula que está sendo lida (O(1) amortizado)--------
+SAT_INTERNO void add_literal (formula *F, int var){
+    if (F->num_literais == F->cap_literais){
+        F->cap_literais *= 2;
+        F->literais = (int*)realloc(F->literais, F->cap_literais * sizeof(int));
+    }
+    F->literais[F->num_literais++] = var;
 }
-//------- Criando uma arvore-------
-raiz *creat_binary_tree ( int var, int max_vars){
-    if (var > max_vars){ // Caso o número de var for maior do que aquele fornecido pelo o arquivo
-        return NULL;
+//---------Fecha a cláusula atual--------
+SAT_INTERNO void add_clausula (formula *F){
+    if (F->num_clausulas + 2 > F->cap_inicio){
+        F->cap_inicio *= 2;
+        F->inicio = (int*)realloc(F->inicio, F->cap_inicio * sizeof(int));
     }
-    raiz *root = (raiz*) malloc(sizeof(raiz));
-    root->var = var;
-    // Filho esquerda (TRUE)
-    root->esquerda = creat_binary_tree( var + 1, max_vars); // Var começa com 0  e vai aumentando de pouco a pouco até chegar no limite
+    F->inicio[++F->num_clausulas] = F->num_literais;
+}
+
+SAT_INTERNO void liberar_formula (formula *F){
+    free(F->inicio);
+    free(F->literais);
+}
+//------Leitura do arquivo .cnf--------
+// O arquivo é lido em blocos grandes e os números são convertidos à mão, sem limite
+// de tamanho de linha; uma cláusula pode ocupar várias linhas (termina no 0).
+#define TAM_BLOCO (1 << 20)
+#define MAX_RESERVA_CLAUSULAS (1 << 20) // O cabeçalho é só uma dica: reserva no máximo isso adiantado
 
-    // Filho direito (FALSE)
-    root->direita = creat_binary_tree( var + 1, max_vars);
-    return root;
+typedef struct leitor{
+    FILE *fp;
+    char *buf;
+    size_t pos;
+    size_t tam;
+    long linha; // Para as mensagens de erro
+}leitor;
+
+static inline int proximo_char (leitor *L){
+    if (L->pos == L->tam){
+        L->tam = fread(L->buf, 1, TAM_BLOCO, L->fp);
+        L->pos = 0;
+        if (L->tam == 0){
+            return EOF;
+        }
+    }
+    return (unsigned char)L->buf[L->pos++];
 }
-//------Adiciona elementos aos literais--------
-No *add_literal (No *head, int var){
-    No *new_node = (No*)malloc(sizeof(No));
-    new_node->item = var ;
-    new_node->next = NULL;
-    
-    // Isso aqui tudo é só para adicionar na ordem que tá no arquivo
-    if (head == NULL){
-        return new_node;
+
+static inline int olhar_char (leitor *L){
+    int ch = proximo_char(L);
+    if (ch != EOF){
+        L->pos--;
     }
-    No *temp = head; 
-    while (temp->next != NULL){
-        temp = temp->next;
+    return ch;
+}
+
+SAT_INTERNO void pular_linha (leitor *L){
+    int ch;
+    while ((ch = proximo_char(L)) != EOF && ch != '\n');
+    L->linha++;
+}
+
+SAT_INTERNO void pular_espacos (leitor *L){
+    int ch;
+    while ((ch = olhar_char(L)) == ' ' || ch == '\t' || ch == '\r' || ch == '\n'){
+        if (ch == '\n'){
+            L->linha++;
+        }
+        L->pos++;
     }
-    temp->next = new_node;
-    return head;
 }
-//---------Adiciona elementos as cláusulas--------
-clausula *add_clausula (clausula *head, No *lit){
-    clausula *new_clausula = (clausula*)malloc(sizeof(clausula));
-    new_clausula->literais = lit;
-    new_clausula->next = NULL; // Não tem mais nenhuma cláusula a ser adicionada na lista ; Por enquanto
 
-    if (head == NULL){ // Não tem nenhum elemento anterior 
-        return new_clausula; // Retorna a lista de cláusula atual
+//------ Lê um inteiro com sinal; retorna false se não houver número válido --------
+SAT_INTERNO bool ler_inteiro (leitor *L, long long *valor){
+    pular_espacos(L);
+    int ch = proximo_char(L);
+    bool negativo = false;
+    if (ch == '-' || ch == '+'){
+        negativo = (ch == '-');
+        ch = proximo_char(L);
+    }
+    if (ch < '0' || ch > '9'){
+        return false;
+    }
+    long long v = 0;
+    while (ch >= '0' && ch <= '9'){
+        v = v * 10 + (ch - '0');
+        if (v > 2147483647LL){ // Não cabe num literal de 32 bits
+            return false;
+        }
+        ch = proximo_char(L);
+    }
+    if (ch != EOF){
+        L->pos--;
     }
-    clausula *temp = head;
+    *valor = negativo ? -v : v;
+    return true;
+}
 
-    while (temp->next != NULL){ // Caso tenha algum elemento, pecorremos até o ultimo nó
-        temp = temp->next ;
+SAT_INTERNO bool ler_palavra (leitor *L, const char *palavra){
+    pular_espacos(L);
+    for (const char *p = palavra; *p; p++){
+        if (proximo_char(L) != *p){
+            return false;
+        }
     }
-    temp->next = new_clausula; // Adicionamos a novo cláusula no fim da lista 
-    return head ; 
+    return true;
 }
-//------Leitura do arquivo .cnf--------
-formula read_formula (FILE *fp){
-    formula F; 
-    F.inicio = NULL;
-    F.num_setencas = 0;
-    F.num_variaveis = 0;
 
-    char line[MAX];
+//------ Lê a fórmula inteira; retorna false (com mensagem) se o arquivo for inválido --------
+SAT_INTERNO bool read_formula (FILE *fp, formula *F){
+    iniciar_formula(F);
+    leitor L = {fp, (char*)malloc(TAM_BLOCO), 0, 0, 1};
+    bool cabecalho = false;
+    bool ok = true;
+    int tam_clausula = 0; // Literais da cláusula aberta
 
-    while (fgets(line, MAX, fp)){
-        if (line[0] == 'c'){ // ignora comentários
+    while (ok){
+        pular_espacos(&L);
+        int ch = olhar_char(&L);
+        if (ch == EOF || ch == '%'){ // Alguns arquivos do SATLIB terminam com "%"
+            break;
+        }
+        if (ch == 'c'){ // ignora comentários
+            pular_linha(&L);
             continue;
         }
-        if (line[0] == 'p'){ // Lê cabeçalho
-            sscanf(line, "p cnf %d %d", &F.num_variaveis, &F.num_setencas);
+        if (ch == 'p'){ // Lê cabeçalho
+            long long v, c;
+            if (cabecalho || !ler_palavra(&L, "p") || !ler_palavra(&L, "cnf") ||
+                !ler_inteiro(&L, &v) || !ler_inteiro(&L, &c) || v < 0 || c < 0 || v > INT_MAX || c > INT_MAX){
+                printf("Erro na linha %ld: cabecalho \"p cnf <variaveis> <clausulas>\" invalido.\n", L.linha);
+                ok = false;
+                break;
+            }
+            cabecalho = true;
+            F->num_variaveis = (int)v;
+            F->num_setencas = (int)c;
+            // Já reserva espaço para as cláusulas anunciadas (limitado: o cabeçalho pode mentir)
+            size_t reserva = (size_t)c + 2;
+            if (reserva > MAX_RESERVA_CLAUSULAS){
+                reserva = MAX_RESERVA_CLAUSULAS;
+            }
+            if (reserva > (size_t)F->cap_inicio){
+                int *novo = (int*)realloc(F->inicio, reserva * sizeof(int));
+                if (novo == NULL){
+                    printf("Erro: memoria insuficiente para as clausulas.\n");
+                    ok = false;
+                    break;
+                }
+                F->inicio = novo;
+                F->cap_inicio = (int)reserva;
+            }
             continue;
         }
+        long long literal;
+        if (!ler_inteiro(&L, &literal)){
+            printf("Erro na linha %ld: literal invalido.\n", L.linha);
+            ok = false;
+            break;
+        }
+        if (!cabecalho){
+            printf("Erro na linha %ld: clausula antes do cabecalho \"p cnf\".\n", L.linha);
+            ok = false;
+            break;
+        }
+        if (literal == 0){
+            add_clausula(F); //fecha a clausula depois de adicionar os literais
+            tam_clausula = 0;
+        }
+        else if (literal > F->num_variaveis || -literal > F->num_variaveis){
+            printf("Erro na linha %ld: variavel %lld fora do intervalo 1..%d do cabecalho.\n",
+                   L.linha, literal < 0 ? -literal : literal, F->num_variaveis);
+            ok = false;
+        }
+        else {
+            add_literal(F, (int)literal); //adiciona os literias a clausula
+            tam_clausula++;
+        }
+    }
+    free(L.buf);
 
-        int literal; 
-        No *literal_head = criar_lista_encadeada();
+    if (ok && !cabecalho){
+        printf("Erro: arquivo sem cabecalho \"p cnf\".\n");
+        ok = false;
+    }
+    if (ok && tam_clausula > 0){ // Última cláusula sem o 0 final
+        printf("c Aviso: ultima clausula sem 0 no final.\n");
+        add_clausula(F);
+    }
+    if (ok && F->num_clausulas != F->num_setencas){
+        printf("c Aviso: cabecalho anuncia %d clausulas, mas o arquivo tem %d.\n", F->num_setencas, F->num_clausulas);
+    }
+    return ok;
+}
 
-        char *token = strtok(line, " \n");
-        while (token != NULL){
-            literal = atoi(token);
-            if (literal == 0){
-                F.inicio = add_clausula(F.inicio, literal_head);//adiciona a clausula depois de adicionar os literais
-                literal_head = NULL;
+//------ Abre o arquivo: "-" (ou nada) é a entrada padrão; ".gz" passa pelo gzip --------
+SAT_INTERNO FILE *abrir_cnf (const char *caminho, bool *via_pipe){
+    *via_pipe = false;
+    if (caminho == NULL || strcmp(caminho, "-") == 0){
+        return stdin;
+    }
+    size_t n = strlen(caminho);
+    if (n > 3 && strcmp(caminho + n - 3, ".gz") == 0){
+        // Monta: gzip -dc '<caminho>' (aspas simples escapadas)
+        char *cmd = (char*)malloc(4 * n + 32);
+        char *p = cmd + sprintf(cmd, "gzip -dc '");
+        for (const char *s = caminho; *s; s++){
+            if (*s == '\''){
+                p += sprintf(p, "'\\''");
             }
             else {
-                literal_head = add_literal(literal_head, literal);//adiciona os literias a clausula
+                *p++ = *s;
             }
-            token = strtok(NULL, " \n");
         }
+        strcpy(p, "'");
+        FILE *fp = popen(cmd, "r");
+        free(cmd);
+        *via_pipe = true;
+        return fp;
     }
-    return F;
+    return fopen(caminho, "r");
 }
-bool eh_sat (formula *F, bool *interpretacoes){ // Acessar os literais, os modificando e  a formula e atraibuindo a um array de booleanos
-    clausula *cl = F->inicio;
-    while (cl != NULL){  //Percorre todas as cláusulas
-        No *lt = cl->literais; //vai receber a lista de literais da clausula atual
+SAT_INTERNO bool eh_sat (formula *F, bool *interpretacoes){ // Confere uma interpretação completa contra a formula original
+    for (int c = 0; c < F->num_clausulas; c++){  //Percorre todas as cláusulas
         bool cl_sat = false; // Assumimos que ela não é sat até ser provado o contrário
-        while (lt != NULL){ // Percorre todos os literias x1 x2 .... da clausula atual
-            int var = lt->item;
+        for (int i = F->inicio[c]; i < F->inicio[c + 1]; i++){ // Percorre todos os literias x1 x2 .... da clausula atual
+            int var = F->literais[i];
             bool valor;
             if (var > 0){ // Se  não tiver negado
-               valor = interpretacoes[var - 1] ; // Pegamos o valor no array de atribuição // Reolhar "interpretacoes[var - 1]""
+               valor = interpretacoes[var - 1] ; // Pegamos o valor no array de atribuição
             }
             else { // Caso não
                 valor = !interpretacoes[-var - 1]; // Vamos negar o valor de atribuição
@@ -133,54 +303,2228 @@ bool eh_sat (formula *F, bool *interpretacoes){ // Acessar os literais, os modif
                 cl_sat = true;
                 break; //Se uma das condições da clausula forn satisfeita, ele já para o loop da clausula
             }
-            lt = lt->next;
         }
         if(!cl_sat){ // Se a cláusula for falsa
             return false;
         }
-        cl = cl->next;
     }
     return true;
 }
-bool SAT_SOLVER (raiz *root, formula *F, bool *interpretacoes, int nivel){
-    if (root == NULL){
-        return eh_sat(F, interpretacoes);
+//=================== PRÉ-PROCESSAMENTO ===================
+// Simplifica a fórmula antes da busca: fixa unitárias e literais puros, apaga cláusulas
+// subsumidas, encurta cláusulas por auto-subsunção e elimina variáveis por resolução
+// quando isso não aumenta o número de cláusulas. As variáveis mantêm a numeração; as
+// eliminadas somem da fórmula e ganham valor de volta em reconstruir().
+//
+// Pilha de reconstrução: cada entrada é [pivô, outros literais..., tamanho]. Percorrida de
+// trás para frente, toda cláusula falsa no modelo faz o seu pivô virar verdadeiro.
+#define LIMITE_OCORRENCIAS 10   // Só elimina x se x ou -x aparece em no máximo tantas cláusulas
+#define MAX_RESOLVENTE 24       // Resolventes maiores que isso desistem da eliminação
+#define RODADAS_PRE 3
+#define ESFORCO_PRE 200000000L  // Literais visitados antes de desistir (fórmulas enormes)
+
+typedef struct preprocessador{
+    int num_vars;
+    vetor *clausulas;     // Literais internos de cada cláusula
+    int num_clausulas, cap_clausulas;
+    bool *removida;
+    uint64_t *assinatura; // Um bit por variável (módulo 64): filtro rápido de subsunção
+    vetor *ocorrencias;   // Cláusulas vivas de cada literal (2n listas)
+    signed char *valor;   // Fatos já descobertos
+    bool *eliminada;
+    bool *tocada;         // Alguma cláusula da variável mudou desde a última tentativa de eliminá-la
+    int *marca;           // Marcação por carimbo, indexada por literal
+    int carimbo;
+    vetor unidades;       // Literais fixados ainda não propagados
+    int prox_unidade;
+    vetor fila;           // Cláusulas a usar como subsumidoras
+    bool *na_fila;
+    vetor temp, resolventes;
+    vetor *reconstrucao;
+    bool inconsistente;
+    long esforco;
+    long subsumidas, fortalecidas, fixas, puras, eliminadas;
+}preprocessador;
+
+SAT_INTERNO void enfileirar_pre (preprocessador *P, int c){
+    if (!P->na_fila[c]){
+        P->na_fila[c] = true;
+        vetor_add(&P->fila, c);
     }
-    interpretacoes[nivel] = true ; // True para a variavel atual
-    if(SAT_SOLVER(root->esquerda, F, interpretacoes, nivel + 1)){
-        return true;
+}
+
+SAT_INTERNO void tirar_ocorrencia (vetor *o, int c){
+    for (int i = 0; i < o->tam; i++){
+        if (o->dados[i] == c){
+            o->dados[i] = o->dados[--o->tam];
+            return;
+        }
     }
-    interpretacoes[nivel] = false;
-    if (SAT_SOLVER(root->direita, F, interpretacoes, nivel + 1)){
-        return true;
+}
+
+SAT_INTERNO void fixar_pre (preprocessador *P, int l){
+    signed char v = P->valor[VAR(l)];
+    if (v != INDEFINIDO){
+        if (v == SINAL(l)){ // Já vale o contrário
+            P->inconsistente = true;
+        }
+        return;
     }
-    return false ;
+    P->valor[VAR(l)] = !SINAL(l);
+    vetor_add(&P->unidades, l);
+    vetor_add(P->reconstrucao, l); // Entrada unitária: força o valor no modelo
+    vetor_add(P->reconstrucao, 1);
+    P->fixas++;
 }
-void solucao (bool *interpretacao, int num_var){
-    printf("SAT !\n");
-    printf("Solucoes :\n");
-    for (int i = 0; i < num_var; i++){
-        printf("x%d = %s\n", i + 1, interpretacao[i] ? "TRUE" : "FALSE");
+
+SAT_INTERNO void remover_clausula_pre (preprocessador *P, int c){
+    vetor *C = &P->clausulas[c];
+    P->removida[c] = true;
+    for (int i = 0; i < C->tam; i++){
+        tirar_ocorrencia(&P->ocorrencias[C->dados[i]], c);
+        P->tocada[VAR(C->dados[i])] = true;
     }
 }
-int main (){
-    FILE *fp = fopen("teste6.cnf", "r");
-    if (fp == NULL){
-        printf("Erro ao abrir o arquivo.\n");
-        return 1;
+
+//------ Guarda uma cláusula já limpa pelos fatos; unitárias viram fatos --------
+SAT_INTERNO void nova_clausula_pre (preprocessador *P, int *lits, int tam){
+    int k = 0;
+    P->carimbo++;
+    for (int i = 0; i < tam; i++){
+        int l = lits[i];
+        signed char v = P->valor[VAR(l)];
+        if (P->marca[NEG(l)] == P->carimbo || (v != INDEFINIDO && v != SINAL(l))){ // Tautologia ou satisfeita
+            return;
+        }
+        if (P->marca[l] == P->carimbo || v != INDEFINIDO){ // Repetido ou falso
+            continue;
+        }
+        P->marca[l] = P->carimbo;
+        lits[k++] = l;
+    }
+    if (k == 0){
+        P->inconsistente = true;
+        return;
+    }
+    if (k == 1){
+        fixar_pre(P, lits[0]);
+        return;
     }
-    formula F = read_formula(fp);
-    fclose(fp);
+    if (P->num_clausulas == P->cap_clausulas){
+        P->cap_clausulas = P->cap_clausulas ? 2 * P->cap_clausulas : 64;
+        P->clausulas = (vetor*)realloc(P->clausulas, P->cap_clausulas * sizeof(vetor));
+        P->removida = (bool*)realloc(P->removida, P->cap_clausulas * sizeof(bool));
+        P->na_fila = (bool*)realloc(P->na_fila, P->cap_clausulas * sizeof(bool));
+        P->assinatura = (uint64_t*)realloc(P->assinatura, P->cap_clausulas * sizeof(uint64_t));
+    }
+    int c = P->num_clausulas++;
+    vetor C = {NULL, 0, 0};
+    P->assinatura[c] = 0;
+    for (int i = 0; i < k; i++){
+        vetor_add(&C, lits[i]);
+        vetor_add(&P->ocorrencias[lits[i]], c);
+        P->tocada[VAR(lits[i])] = true;
+        P->assinatura[c] |= 1ULL << (VAR(lits[i]) & 63);
+    }
+    P->clausulas[c] = C;
+    P->removida[c] = false;
+    P->na_fila[c] = false;
+    enfileirar_pre(P, c);
+}
 
-    raiz *root = creat_binary_tree(1, F.num_variaveis);
-    bool *interpretacao = (bool*)malloc(F.num_variaveis * sizeof(bool));
+//------ Tira o literal l da cláusula c (resolução com uma cláusula que a subsume quase) --------
+SAT_INTERNO void tirar_literal_pre (preprocessador *P, int c, int l){
+    vetor *C = &P->clausulas[c];
+    for (int i = 0; i < C->tam; i++){
+        if (C->dados[i] == l){
+            C->dados[i] = C->dados[--C->tam];
+            break;
+        }
+    }
+    tirar_ocorrencia(&P->ocorrencias[l], c);
+    if (C->tam == 1){
+        int u = C->dados[0];
+        remover_clausula_pre(P, c);
+        fixar_pre(P, u);
+        return;
+    }
+    P->assinatura[c] = 0;
+    for (int i = 0; i < C->tam; i++){
+        P->assinatura[c] |= 1ULL << (VAR(C->dados[i]) & 63);
+        P->tocada[VAR(C->dados[i])] = true;
+    }
+    enfileirar_pre(P, c);
+}
+
+SAT_INTERNO void propagar_pre (preprocessador *P){
+    while (P->prox_unidade < P->unidades.tam && !P->inconsistente){
+        int l = P->unidades.dados[P->prox_unidade++];
+        while (P->ocorrencias[l].tam > 0){ // Satisfeitas: somem
+            remover_clausula_pre(P, P->ocorrencias[l].dados[0]);
+        }
+        while (P->ocorrencias[NEG(l)].tam > 0 && !P->inconsistente){ // Perdem o literal falso
+            tirar_literal_pre(P, P->ocorrencias[NEG(l)].dados[0], NEG(l));
+        }
+    }
+}
+
+//------ Usa a cláusula c para apagar as que ela subsume e encurtar as que quase subsume --------
+SAT_INTERNO void subsumir_pre (preprocessador *P, int c){
+    vetor *C = &P->clausulas[c];
+    int melhor = C->dados[0];
+    for (int i = 1; i < C->tam; i++){ // Basta olhar as cláusulas de um literal de c (o mais raro)
+        int l = C->dados[i];
+        if (P->ocorrencias[l].tam + P->ocorrencias[NEG(l)].tam <
+            P->ocorrencias[melhor].tam + P->ocorrencias[NEG(melhor)].tam){
+            melhor = l;
+        }
+    }
+    P->temp.tam = 0;
+    for (int s = 0; s < 2; s++){
+        vetor *o = &P->ocorrencias[s ? NEG(melhor) : melhor];
+        for (int i = 0; i < o->tam; i++){
+            vetor_add(&P->temp, o->dados[i]);
+        }
+    }
+    for (int i = 0; i < P->temp.tam && !P->removida[c]; i++){
+        int d = P->temp.dados[i];
+        vetor *D = &P->clausulas[d];
+        if (d == c || P->removida[d] || D->tam < C->tam || (P->assinatura[c] & ~P->assinatura[d]) != 0){
+            continue;
+        }
+        P->esforco -= C->tam + D->tam;
+        P->carimbo++;
+        for (int j = 0; j < D->tam; j++){
+            P->marca[D->dados[j]] = P->carimbo;
+        }
+        int trocado = -1; // Literal de d cuja negação está em c
+        bool serve = true;
+        for (int j = 0; j < C->tam && serve; j++){
+            int l = C->dados[j];
+            if (P->marca[l] == P->carimbo){
+                continue;
+            }
+            if (trocado < 0 && P->marca[NEG(l)] == P->carimbo){
+                trocado = NEG(l);
+            }
+            else {
+                serve = false;
+            }
+        }
+        if (!serve){
+            continue;
+        }
+        if (trocado < 0){ // c está contida em d
+            remover_clausula_pre(P, d);
+            P->subsumidas++;
+        }
+        else { // Resolver c com d dá d sem o literal trocado, que subsume d
+            tirar_literal_pre(P, d, trocado);
+            P->fortalecidas++;
+        }
+    }
+}
+
+SAT_INTERNO void subsumir_fila (preprocessador *P){
+    while (P->fila.tam > 0 && !P->inconsistente && P->esforco > 0){
+        int c = P->fila.dados[--P->fila.tam];
+        P->na_fila[c] = false;
+        if (!P->removida[c]){
+            subsumir_pre(P, c);
+        }
+        propagar_pre(P);
+    }
+}
+
+//------ Elimina v se os resolventes não são mais numerosos que as cláusulas de v --------
+SAT_INTERNO bool eliminar_variavel_pre (preprocessador *P, int v){
+    vetor *pos = &P->ocorrencias[2 * v];
+    vetor *neg = &P->ocorrencias[2 * v + 1];
+    if (P->valor[v] != INDEFINIDO || P->eliminada[v] || !P->tocada[v] || (pos->tam == 0 && neg->tam == 0)){
+        return false;
+    }
+    P->tocada[v] = false; // Se não der agora, só vale tentar de novo depois de alguma mudança
+    if (pos->tam == 0 || neg->tam == 0){ // Literal puro: basta torná-lo verdadeiro
+        fixar_pre(P, pos->tam ? 2 * v : 2 * v + 1);
+        P->puras++;
+        return true;
+    }
+    if (pos->tam > LIMITE_OCORRENCIAS && neg->tam > LIMITE_OCORRENCIAS){
+        return false;
+    }
+    // Resolventes em sequência [tamanho, literais...]
+    P->resolventes.tam = 0;
+    int limite = pos->tam + neg->tam;
+    int gerados = 0;
+    for (int i = 0; i < pos->tam; i++){
+        vetor *C = &P->clausulas[pos->dados[i]];
+        for (int j = 0; j < neg->tam; j++){
+            vetor *D = &P->clausulas[neg->dados[j]];
+            P->esforco -= C->tam + D->tam;
+            P->carimbo++;
+            int inicio = P->resolventes.tam;
+            vetor_add(&P->resolventes, 0);
+            for (int k = 0; k < C->tam; k++){
+                if (VAR(C->dados[k]) != v){
+                    P->marca[C->dados[k]] = P->carimbo;
+                    vetor_add(&P->resolventes, C->dados[k]);
+                }
+            }
+            bool tautologia = false;
+            for (int k = 0; k < D->tam && !tautologia; k++){
+                int l = D->dados[k];
+                if (VAR(l) == v || P->marca[l] == P->carimbo){
+                    continue;
+                }
+                if (P->marca[NEG(l)] == P->carimbo){
+                    tautologia = true;
+                }
+                else {
+                    vetor_add(&P->resolventes, l);
+                }
+            }
+            int tam = P->resolventes.tam - inicio - 1;
+            if (tautologia){
+                P->resolventes.tam = inicio;
+                continue;
+            }
+            if (++gerados > limite || tam > MAX_RESOLVENTE){
+                return false;
+            }
+            P->resolventes.dados[inicio] = tam;
+        }
+    }
+    // Guarda o lado menor na pilha; o pivô começa com o valor que falsifica esse lado
+    int p = (pos->tam <= neg->tam) ? 2 * v : 2 * v + 1;
+    vetor *lado = &P->ocorrencias[p];
+    for (int i = 0; i < lado->tam; i++){
+        vetor *C = &P->clausulas[lado->dados[i]];
+        vetor_add(P->reconstrucao, p);
+        for (int k = 0; k < C->tam; k++){
+            if (C->dados[k] != p){
+                vetor_add(P->reconstrucao, C->dados[k]);
+            }
+        }
+        vetor_add(P->reconstrucao, C->tam);
+    }
+    vetor_add(P->reconstrucao, NEG(p));
+    vetor_add(P->reconstrucao, 1);
+    while (pos->tam > 0){
+        remover_clausula_pre(P, pos->dados[0]);
+    }
+    while (neg->tam > 0){
+        remover_clausula_pre(P, neg->dados[0]);
+    }
+    P->eliminada[v] = true;
+    P->eliminadas++;
+    for (int i = 0; i < P->resolventes.tam; i += P->resolventes.dados[i] + 1){
+        nova_clausula_pre(P, &P->resolventes.dados[i + 1], P->resolventes.dados[i]);
+    }
+    return true;
+}
 
-    if (SAT_SOLVER(root, &F, interpretacao, 0)){
-        solucao(interpretacao, F.num_variaveis);
+SAT_INTERNO int comparar_chave (const void *a, const void *b){
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+//------ Simplifica F em G; a pilha recebe o que reconstruir() precisa para voltar a F --------
+SAT_INTERNO void preprocessar (formula *F, formula *G, vetor *pilha){
+    clock_t inicio = clock();
+    int n = F->num_variaveis;
+    preprocessador *P = (preprocessador*)calloc(1, sizeof(preprocessador));
+    P->num_vars = n;
+    P->ocorrencias = (vetor*)calloc(2 * n, sizeof(vetor));
+    P->valor = (signed char*)malloc(n * sizeof(signed char));
+    memset(P->valor, INDEFINIDO, n * sizeof(signed char));
+    P->eliminada = (bool*)calloc(n, sizeof(bool));
+    P->tocada = (bool*)calloc(n, sizeof(bool));
+    P->marca = (int*)calloc(2 * n, sizeof(int));
+    P->reconstrucao = pilha;
+    P->esforco = ESFORCO_PRE;
+
+    vetor lits = {NULL, 0, 0};
+    for (int c = 0; c < F->num_clausulas && !P->inconsistente; c++){
+        lits.tam = 0;
+        for (int i = F->inicio[c]; i < F->inicio[c + 1]; i++){
+            vetor_add(&lits, LIT(F->literais[i]));
+        }
+        nova_clausula_pre(P, lits.dados, lits.tam);
+    }
+    propagar_pre(P);
+
+    uint64_t *ordem = (uint64_t*)malloc((n + 1) * sizeof(uint64_t));
+    for (int rodada = 0; rodada < RODADAS_PRE && !P->inconsistente && P->esforco > 0; rodada++){
+        subsumir_fila(P);
+        // Variáveis com menos ocorrências primeiro: são as que mais provavelmente saem barato
+        for (int v = 0; v < n; v++){
+            uint64_t ocorr = P->ocorrencias[2 * v].tam + P->ocorrencias[2 * v + 1].tam;
+            ordem[v] = (ocorr << 32) | (uint64_t)v;
+        }
+        qsort(ordem, n, sizeof(uint64_t), comparar_chave);
+        long antes = P->eliminadas + P->puras;
+        for (int i = 0; i < n && !P->inconsistente && P->esforco > 0; i++){
+            if (eliminar_variavel_pre(P, (int)(ordem[i] & 0xFFFFFFFF))){
+                propagar_pre(P);
+            }
+        }
+        subsumir_fila(P);
+        if (P->eliminadas + P->puras == antes){
+            break;
+        }
+    }
+    free(ordem);
+
+    // Monta a fórmula simplificada (uma cláusula vazia se já deu contradição)
+    iniciar_formula(G);
+    G->num_variaveis = n;
+    if (P->inconsistente){
+        add_clausula(G);
     }
     else {
-        printf("UNSAT!\n");
+        for (int c = 0; c < P->num_clausulas; c++){
+            if (P->removida[c]){
+                continue;
+            }
+            for (int i = 0; i < P->clausulas[c].tam; i++){
+                int l = P->clausulas[c].dados[i];
+                add_literal(G, SINAL(l) ? -(VAR(l) + 1) : VAR(l) + 1);
+            }
+            add_clausula(G);
+        }
+    }
+    G->num_setencas = G->num_clausulas;
+    printf("c pre: %d -> %d clausulas, %d -> %d literais; %ld fixas, %ld puras, %ld eliminadas, "
+           "%ld subsumidas, %ld fortalecidas em %.2fs\n", F->num_clausulas, G->num_clausulas,
+           F->num_literais, G->num_literais, P->fixas - P->puras, P->puras, P->eliminadas,
+           P->subsumidas, P->fortalecidas, (double)(clock() - inicio) / CLOCKS_PER_SEC);
+
+    for (int c = 0; c < P->num_clausulas; c++){
+        free(P->clausulas[c].dados);
+    }
+    for (int i = 0; i < 2 * n; i++){
+        free(P->ocorrencias[i].dados);
+    }
+    free(lits.dados); free(P->clausulas); free(P->removida); free(P->na_fila); free(P->assinatura);
+    free(P->ocorrencias); free(P->valor); free(P->eliminada); free(P->tocada); free(P->marca);
+    free(P->unidades.dados); free(P->fila.dados); free(P->temp.dados); free(P->resolventes.dados);
+    free(P);
+}
+
+//------ Leva um modelo da fórmula simplificada a um modelo da original --------
+SAT_INTERNO void reconstruir (vetor *pilha, bool *interpretacoes){
+    int i = pilha->tam;
+    while (i > 0){
+        int tam = pilha->dados[i - 1];
+        int *lits = &pilha->dados[i - 1 - tam];
+        bool satisfeita = false;
+        for (int k = 0; k < tam && !satisfeita; k++){
+            satisfeita = (interpretacoes[VAR(lits[k])] == !SINAL(lits[k]));
+        }
+        if (!satisfeita){
+            interpretacoes[VAR(lits[0])] = !SINAL(lits[0]);
+        }
+        i -= tam + 1;
+    }
+}
+
+//=================== SOLVER CDCL (DOIS LITERAIS VIGIADOS + APRENDIZADO) ===================
+#define REINICIO_LUBY 0    // Reinicia após luby(i) * UNIDADE_LUBY conflitos
+#define REINICIO_GLUCOSE 1 // Reinicia quando a média recente de LBD fica alta (estilo Glucose)
+#define UNIDADE_LUBY 100
+#define REDUCAO_INICIAL 2000 // Conflitos até a primeira limpeza das cláusulas aprendidas
+#define REDUCAO_PASSO 300    // Quanto o intervalo entre limpezas cresce
+#define HEURISTICA_VSIDS 0   // Variável mais ativa nos conflitos recentes (EVSIDS)
+#define HEURISTICA_ORDEM 1   // Menor índice ainda sem valor
+#define DECAIMENTO 0.95      // A cada conflito as atividades antigas valem 5% menos
+#define MODO_CDCL 0          // Busca normal
+#define MODO_EXAUSTIVO 1     // Força bruta bit-paralela (fórmulas pequenas)
+#define MODO_CONTAR 2        // Força bruta contando todos os modelos
+#define MODO_ENUMERAR 3      // Força bruta imprimindo todos os modelos
+#define MODO_CONFERIR 4      // Roda CDCL e força bruta e compara as respostas
+
+//---- Opções de busca (escolhidas na linha de comando) ------
+typedef struct opcoes{
+    int heuristica;
+    int politica_reinicio;
+    bool salvar_fase;       // Repete o último valor que a variável teve
+    bool fase_inicial;      // Valor tentado primeiro quando não há fase salva
+    int modo;
+    int threads;
+    int portfolio;          // Número de solvers diferentes rodando juntos (1 = sem portfólio)
+    int cubos;              // Threads do cubo-e-conquista (0 = desligado)
+    int profundidade;       // Profundidade do lookahead que gera os cubos (0 = automática)
+    bool simplificar;       // Pré-processa a fórmula antes da busca
+    uint64_t semente;       // 0 = busca determinística
+    double freq_aleatoria;  // Chance de uma decisão pegar uma variável qualquer
+}opcoes;
+
+//---- Arena de cláusulas ------
+// Todas as cláusulas ficam num único vetor de int. Uma cláusula é identificada pela
+// posição do seu cabeçalho (cref) e ocupa CABECALHO + tam posições:
+//   arena[cref]     = tamanho
+//   arena[cref + 1] = LBD << 2 | APAGADA | APRENDIDA
+//   arena[cref + 2] ... literais (as posições 0 e 1 são os vigiados)
+#define CABECALHO 2
+#define APRENDIDA 1
+#define APAGADA 2
+#define CL_TAM(S, c) ((S)->arena[c])
+#define CL_INFO(S, c) ((S)->arena[(c) + 1])
+#define CL_LITS(S, c) (&(S)->arena[(c) + CABECALHO])
+#define CL_LBD(S, c) (CL_INFO(S, c) >> 2)
+
+//---- Vigia: cláusula + um literal dela (se o bloqueador já é verdadeiro, nem abre a cláusula) ------
+typedef struct vigia{
+    int cref;
+    int bloqueador;
+}vigia;
+
+typedef struct lista_vigias{
+    vigia *dados;
+    int tam;
+    int cap;
+}lista_vigias;
+
+//---- Cláusulas compartilhadas entre as threads do portfólio ------
+// Buffer circular sem trava: quem escreve reserva uma posição com fetch_add e só escreve se
+// conseguir "fechar" a entrada (número de sequência ímpar); quem lê confere o número antes e
+// depois de copiar. Entradas sobrescritas ou em escrita são simplesmente puladas.
+#define TAM_COMPARTILHADO 4096 // Potência de 2
+#define MAX_LITS_COMPARTILHADA 8
+#define MAX_LBD_COMPARTILHADA 3
+
+typedef struct entrada_compartilhada{
+    _Atomic uint64_t seq;      // 2 * idx + 1 durante a escrita, 2 * idx + 2 quando pronta
+    _Atomic int origem;        // Thread que aprendeu a cláusula
+    _Atomic int tam;
+    _Atomic int lbd;
+    _Atomic int lits[MAX_LITS_COMPARTILHADA];
+}entrada_compartilhada;
+
+typedef struct compartilhado{
+    _Atomic uint64_t cabeca;   // Próxima posição a escrever
+    _Atomic int vencedor;      // 0 enquanto ninguém terminou; depois, id + 1 de quem terminou
+    entrada_compartilhada buf[TAM_COMPARTILHADO];
+}compartilhado;
+
+typedef struct solver{
+    int num_vars;
+    int *arena;           // Cabeçalhos e literais de todas as cláusulas
+    int arena_tam;
+    int arena_cap;
+    vetor originais;      // crefs das cláusulas da fórmula
+    vetor aprendidas;     // crefs das cláusulas aprendidas
+    lista_vigias *vigias; // vigias[l] = cláusulas que vigiam o literal l (visitadas quando l fica FALSO)
+    signed char *valores; // Valor de cada variável
+    int *nivel;           // Nível de decisão em que a variável recebeu valor
+    int *razao;           // Cláusula que forçou o valor (-1 para decisões)
+    int *trilha;          // Literais verdadeiros na ordem de atribuição
+    int topo;
+    int qhead;            // Próximo literal da trilha a propagar
+    int *lim;             // Início de cada nível de decisão na trilha
+    int num_niveis;
+    bool inconsistente;   // Conflito já no nível 0 (ex.: cláusula vazia)
+    int *marca;           // Auxiliar para remover literais repetidos
+    int carimbo;          // Valor atual da marca (muda a cada cláusula)
+    // Auxiliares da análise de conflito
+    bool *visto;
+    vetor aprendida;
+    vetor limpar;
+    vetor pilha;
+    int *marca_nivel;     // Para contar níveis distintos (LBD)
+    int carimbo_nivel;
+    opcoes op;
+    // Heurística de decisão
+    double *atividade;
+    double incremento;    // Quanto vale um conflito agora (cresce em vez de decair todas)
+    int *heap;            // Heap de máximo das variáveis por atividade
+    int *pos_heap;        // Posição da variável no heap (-1 se não está)
+    int tam_heap;
+    bool *fase;           // Último valor de cada variável (phase saving)
+    int proxima;          // HEURISTICA_ORDEM: variáveis abaixo deste índice já têm valor
+    // Reinícios e limpeza
+    double ema_rapida;    // Média móvel do LBD das últimas cláusulas
+    double ema_lenta;     // Média móvel de longo prazo
+    long conflitos_reinicio; // Conflitos desde o último reinício
+    long prox_reducao;
+    int reducoes;
+    // Estatísticas
+    long decisoes;
+    long propagacoes;
+    long conflitos;
+    long reinicios;
+    // Portfólio
+    compartilhado *comp;  // NULL quando o solver roda sozinho
+    int id;
+    uint64_t lido;        // Próxima posição do buffer compartilhado a importar
+    uint64_t aleatorio;   // Estado do gerador pseudoaleatório
+    long importadas;
+    // Suposições (literais fixados como as primeiras decisões) e limite de esforço
+    vetor suposicoes;
+    int cap_niveis;       // Capacidade de lim/marca_nivel (variáveis + suposições + 1)
+    long limite_conflitos; // Para com RES_DESCONHECIDO ao passar deste total (-1 = sem limite)
+    // Uso incremental (sat.h)
+    vetor falhas;         // Suposições que explicam o último RES_UNSAT
+    vetor escopos;        // Literais de ativação dos escopos abertos por sat_empurrar
+    signed char *modelo;  // Cópia do último modelo (sobrevive a novas cláusulas)
+    int tam_modelo;       // Variáveis que existiam quando o modelo foi copiado
+    int cap_vars;         // Capacidade dos vetores indexados por variável
+}solver;
+
+SAT_INTERNO void vigia_add (lista_vigias *w, int cref, int bloqueador){
+    if (w->tam == w->cap){
+        w->cap = w->cap ? 2 * w->cap : 4;
+        w->dados = (vigia*)realloc(w->dados, w->cap * sizeof(vigia));
+    }
+    w->dados[w->tam].cref = cref;
+    w->dados[w->tam].bloqueador = bloqueador;
+    w->tam++;
+}
+
+SAT_INTERNO signed char valor_lit (solver *S, int l){
+    signed char v = S->valores[VAR(l)];
+    if (v == INDEFINIDO){
+        return INDEFINIDO;
+    }
+    return v ^ SINAL(l); // Literal negado inverte o valor da variável
+}
+
+SAT_INTERNO void atribuir (solver *S, int l, int razao){
+    int v = VAR(l);
+    S->valores[v] = SINAL(l) ? FALSO : VERDADEIRO;
+    S->nivel[v] = S->num_niveis;
+    S->razao[v] = razao;
+    S->trilha[S->topo++] = l;
+}
+
+SAT_INTERNO void vigiar (solver *S, int cref){
+    int *lits = CL_LITS(S, cref);
+    vigia_add(&S->vigias[lits[0]], cref, lits[1]);
+    vigia_add(&S->vigias[lits[1]], cref, lits[0]);
+}
+
+//------ Gerador xorshift64* (cada solver tem o seu, sem estado global) --------
+SAT_INTERNO uint64_t proximo_aleatorio (solver *S){
+    S->aleatorio ^= S->aleatorio >> 12;
+    S->aleatorio ^= S->aleatorio << 25;
+    S->aleatorio ^= S->aleatorio >> 27;
+    return S->aleatorio * 2685821657736338717ULL;
+}
+
+SAT_INTERNO double aleatorio_real (solver *S){ // Em [0, 1)
+    return (proximo_aleatorio(S) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//------ Heap de variáveis por atividade --------
+SAT_INTERNO void heap_subir (solver *S, int i){
+    int v = S->heap[i];
+    while (i > 0){
+        int pai = (i - 1) / 2;
+        if (S->atividade[S->heap[pai]] >= S->atividade[v]) break;
+        S->heap[i] = S->heap[pai];
+        S->pos_heap[S->heap[i]] = i;
+        i = pai;
+    }
+    S->heap[i] = v;
+    S->pos_heap[v] = i;
+}
+
+SAT_INTERNO void heap_descer (solver *S, int i){
+    int v = S->heap[i];
+    while (2 * i + 1 < S->tam_heap){
+        int filho = 2 * i + 1;
+        if (filho + 1 < S->tam_heap && S->atividade[S->heap[filho + 1]] > S->atividade[S->heap[filho]]){
+            filho++;
+        }
+        if (S->atividade[v] >= S->atividade[S->heap[filho]]) break;
+        S->heap[i] = S->heap[filho];
+        S->pos_heap[S->heap[i]] = i;
+        i = filho;
+    }
+    S->heap[i] = v;
+    S->pos_heap[v] = i;
+}
+
+SAT_INTERNO void heap_inserir (solver *S, int v){
+    if (S->pos_heap[v] >= 0){
+        return;
+    }
+    S->heap[S->tam_heap] = v;
+    S->pos_heap[v] = S->tam_heap;
+    S->tam_heap++;
+    heap_subir(S, S->tam_heap - 1);
+}
+
+SAT_INTERNO int heap_remover_max (solver *S){
+    int v = S->heap[0];
+    S->pos_heap[v] = -1;
+    S->tam_heap--;
+    if (S->tam_heap > 0){
+        S->heap[0] = S->heap[S->tam_heap];
+        S->pos_heap[S->heap[0]] = 0;
+        heap_descer(S, 0);
+    }
+    return v;
+}
+
+//------ EVSIDS: aumenta a atividade de uma variável que participou do conflito --------
+SAT_INTERNO void aumentar_atividade (solver *S, int v){
+    S->atividade[v] += S->incremento;
+    if (S->atividade[v] > 1e100){ // Reescala tudo para não estourar o double
+        for (int i = 0; i < S->num_vars; i++){
+            S->atividade[i] *= 1e-100;
+        }
+        S->incremento *= 1e-100;
+    }
+    if (S->pos_heap[v] >= 0){
+        heap_subir(S, S->pos_heap[v]);
+    }
+}
+
+//------ Copia a cláusula para o fim da arena e retorna seu cref --------
+SAT_INTERNO int guardar_clausula (solver *S, int *lits, int tam, bool aprendida, int lbd){
+    if (S->arena_tam + CABECALHO + tam > S->arena_cap){
+        while (S->arena_tam + CABECALHO + tam > S->arena_cap){
+            S->arena_cap = S->arena_cap ? 2 * S->arena_cap : 1024;
+        }
+        S->arena = (int*)realloc(S->arena, S->arena_cap * sizeof(int));
+    }
+    int cref = S->arena_tam;
+    S->arena[cref] = tam;
+    S->arena[cref + 1] = (lbd << 2) | (aprendida ? APRENDIDA : 0);
+    if (tam > 0){ // Cláusula vazia: lits pode ser NULL
+        memcpy(&S->arena[cref + CABECALHO], lits, tam * sizeof(int));
+    }
+    S->arena_tam += CABECALHO + tam;
+    vetor_add(aprendida ? &S->aprendidas : &S->originais, cref);
+    if (tam >= 2){
+        vigiar(S, cref);
+    }
+    return cref;
+}
+
+//------ Adiciona uma cláusula original (literais no formato interno) --------
+SAT_INTERNO void adicionar_clausula (solver *S, int *lits, int tam){
+    int k = 0;
+    S->carimbo++;
+    for (int i = 0; i < tam; i++){ // Limpa no próprio vetor de entrada
+        int l = lits[i];
+        if (S->marca[l] == S->carimbo || valor_lit(S, l) == FALSO){ // Repetido ou falso no nível 0
+            continue;
+        }
+        if (valor_lit(S, l) == VERDADEIRO){ // Já satisfeita por um fato do nível 0
+            return;
+        }
+        if (S->marca[NEG(l)] == S->carimbo){ // x OU -x: cláusula sempre verdadeira
+            return;
+        }
+        S->marca[l] = S->carimbo;
+        lits[k++] = l;
+    }
+    int cref = guardar_clausula(S, lits, k, false, 0);
+
+    if (k == 0){
+        S->inconsistente = true;
+    }
+    else if (k == 1){ // Cláusula unitária: valor fixo no nível 0
+        signed char v = valor_lit(S, lits[0]);
+        if (v == FALSO){
+            S->inconsistente = true;
+        }
+        else if (v == INDEFINIDO){
+            atribuir(S, lits[0], cref);
+        }
+    }
+}
+
+SAT_INTERNO solver *criar_solver (formula *F, opcoes *op){
+    solver *S = (solver*)calloc(1, sizeof(solver));
+    int n = F->num_variaveis;
+    S->num_vars = n;
+    S->vigias = (lista_vigias*)calloc(2 * n, sizeof(lista_vigias));
+    S->valores = (signed char*)malloc(n * sizeof(signed char));
+    S->nivel = (int*)malloc(n * sizeof(int));
+    S->razao = (int*)malloc(n * sizeof(int));
+    S->trilha = (int*)malloc(n * sizeof(int));
+    S->cap_vars = n;
+    S->cap_niveis = n + 1;
+    S->lim = (int*)malloc(S->cap_niveis * sizeof(int));
+    S->marca = (int*)calloc(2 * n, sizeof(int));
+    S->visto = (bool*)calloc(n, sizeof(bool));
+    S->marca_nivel = (int*)calloc(S->cap_niveis, sizeof(int));
+    S->limite_conflitos = -1;
+    S->op = *op;
+    S->atividade = (double*)calloc(n, sizeof(double));
+    S->incremento = 1.0;
+    S->heap = (int*)malloc(n * sizeof(int));
+    S->pos_heap = (int*)malloc(n * sizeof(int));
+    S->fase = (bool*)malloc(n * sizeof(bool));
+    S->prox_reducao = REDUCAO_INICIAL;
+    S->aleatorio = op->semente * 0x9E3779B97F4A7C15ULL + 1;
+    for (int i = 0; i < n; i++){
+        S->valores[i] = INDEFINIDO;
+        S->fase[i] = op->fase_inicial;
+        S->pos_heap[i] = -1;
+        if (op->semente != 0){ // Desempata as atividades iniciais de um jeito diferente em cada solver
+            S->atividade[i] = aleatorio_real(S) * 1e-5;
+        }
+        heap_inserir(S, i); // Atividades iguais: fica na ordem do índice
+    }
+
+    // A arena já nasce com o tamanho da fórmula, sem realocações durante a carga
+    S->arena_cap = F->num_literais + CABECALHO * F->num_clausulas + 1024;
+    S->arena = (int*)malloc(S->arena_cap * sizeof(int));
+
+    vetor lits = {NULL, 0, 0};
+    for (int c = 0; c < F->num_clausulas; c++){
+        lits.tam = 0;
+        for (int i = F->inicio[c]; i < F->inicio[c + 1]; i++){
+            vetor_add(&lits, LIT(F->literais[i]));
+        }
+        adicionar_clausula(S, lits.dados, lits.tam);
+    }
+    free(lits.dados);
+    return S;
+}
+
+SAT_INTERNO void liberar_solver (solver *S){
+    for (int i = 0; i < 2 * S->num_vars; i++){
+        free(S->vigias[i].dados);
+    }
+    free(S->arena); free(S->originais.dados); free(S->aprendidas.dados); free(S->vigias);
+    free(S->valores); free(S->nivel); free(S->razao);
+    free(S->trilha); free(S->lim); free(S->marca);
+    free(S->visto); free(S->marca_nivel);
+    free(S->atividade); free(S->heap); free(S->pos_heap); free(S->fase);
+    free(S->aprendida.dados); free(S->limpar.dados); free(S->pilha.dados);
+    free(S->suposicoes.dados);
+    free(S->falhas.dados); free(S->escopos.dados); free(S->modelo);
+    free(S);
+}
+
+//------ Propagação de unidades: retorna a cláusula em conflito ou -1 --------
+SAT_INTERNO int propagar (solver *S){
+    while (S->qhead < S->topo){
+        int falso = NEG(S->trilha[S->qhead++]); // Literal que acabou de ficar FALSO
+        lista_vigias *ws = &S->vigias[falso];
+        vigia *i = ws->dados, *j = ws->dados, *fim = ws->dados + ws->tam;
+        S->propagacoes++;
+        while (i < fim){
+            if (valor_lit(S, i->bloqueador) == VERDADEIRO){ // Satisfeita, sem tocar na arena
+                *j++ = *i++;
+                continue;
+            }
+            int c = i->cref;
+            int bloqueador = i->bloqueador;
+            int *lits = CL_LITS(S, c);
+            if (lits[0] == falso){ // Deixa o literal falso na posição 1
+                lits[0] = lits[1];
+                lits[1] = falso;
+            }
+            i++;
+            vigia w = {c, lits[0]};
+            if (lits[0] != bloqueador && valor_lit(S, lits[0]) == VERDADEIRO){ // Cláusula já satisfeita
+                *j++ = w;
+                continue;
+            }
+            // Procura outro literal não falso para vigiar
+            bool achou = false;
+            int tam = CL_TAM(S, c);
+            for (int k = 2; k < tam; k++){
+                if (valor_lit(S, lits[k]) != FALSO){
+                    lits[1] = lits[k];
+                    lits[k] = falso;
+                    vigia_add(&S->vigias[lits[1]], c, lits[0]);
+                    achou = true;
+                    break;
+                }
+            }
+            if (achou){
+                continue;
+            }
+            *j++ = w;
+            if (valor_lit(S, lits[0]) == FALSO){ // Todos falsos: conflito
+                while (i < fim){
+                    *j++ = *i++;
+                }
+                ws->tam = j - ws->dados;
+                S->qhead = S->topo;
+                return c;
+            }
+            atribuir(S, lits[0], c); // Cláusula unitária: lits[0] é forçado
+        }
+        ws->tam = j - ws->dados;
+    }
+    return -1;
+}
+
+//------ Desfaz as atribuições até o nível indicado --------
+SAT_INTERNO void retroceder (solver *S, int nivel){
+    if (S->num_niveis <= nivel){
+        return;
+    }
+    for (int i = S->topo - 1; i >= S->lim[nivel]; i--){
+        int v = VAR(S->trilha[i]);
+        S->fase[v] = !SINAL(S->trilha[i]);
+        S->valores[v] = INDEFINIDO;
+        heap_inserir(S, v);
+    }
+    S->topo = S->lim[nivel];
+    S->qhead = S->topo;
+    S->num_niveis = nivel;
+    S->proxima = 0;
+}
+
+//------ Escolhe o próximo literal de decisão (-1 se tudo já tem valor) --------
+SAT_INTERNO int escolher_literal (solver *S){
+    int v = -1;
+    if (S->op.freq_aleatoria > 0 && S->tam_heap > 0 && aleatorio_real(S) < S->op.freq_aleatoria){
+        int cand = S->heap[proximo_aleatorio(S) % S->tam_heap];
+        if (S->valores[cand] == INDEFINIDO){
+            v = cand;
+        }
+    }
+    if (v < 0 && S->op.heuristica == HEURISTICA_ORDEM){
+        while (S->proxima < S->num_vars && S->valores[S->proxima] != INDEFINIDO){
+            S->proxima++;
+        }
+        if (S->proxima < S->num_vars){
+            v = S->proxima;
+        }
+    }
+    else if (v < 0){
+        while (S->tam_heap > 0){
+            int cand = heap_remover_max(S);
+            if (S->valores[cand] == INDEFINIDO){
+                v = cand;
+                break;
+            }
+        }
+    }
+    if (v < 0){
+        return -1;
+    }
+    bool valor = S->op.salvar_fase ? S->fase[v] : S->op.fase_inicial;
+    return valor ? 2 * v : 2 * v + 1;
+}
+
+SAT_INTERNO void novo_nivel (solver *S){
+    S->lim[S->num_niveis] = S->topo;
+    S->num_niveis++;
+}
+
+//------ Minimização: o literal é implicado pelos outros da cláusula aprendida? --------
+SAT_INTERNO unsigned nivel_abstrato (solver *S, int v){
+    return 1u << (S->nivel[v] & 31);
+}
+
+SAT_INTERNO bool literal_redundante (solver *S, int p, unsigned niveis){
+    S->pilha.tam = 0;
+    vetor_add(&S->pilha, p);
+    int inicio = S->limpar.tam;
+    while (S->pilha.tam > 0){
+        int q = S->pilha.dados[--S->pilha.tam];
+        int c = S->razao[VAR(q)];
+        int *lits = CL_LITS(S, c);
+        int tam = CL_TAM(S, c);
+        for (int i = 1; i < tam; i++){ // lits[0] é o próprio q
+            int l = lits[i];
+            int v = VAR(l);
+            if (S->visto[v] || S->nivel[v] == 0){
+                continue;
+            }
+            if (S->razao[v] != -1 && (nivel_abstrato(S, v) & niveis)){
+                S->visto[v] = true;
+                vetor_add(&S->pilha, l);
+                vetor_add(&S->limpar, l);
+            }
+            else { // Chegou numa decisão ou num nível fora da cláusula: não dá para remover
+                for (int j = inicio; j < S->limpar.tam; j++){
+                    S->visto[VAR(S->limpar.dados[j])] = false;
+                }
+                S->limpar.tam = inicio;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//------ Análise do conflito (1-UIP): monta a cláusula aprendida e o nível de retorno --------
+SAT_INTERNO int analisar (solver *S, int confl){
+    vetor *apr = &S->aprendida;
+    apr->tam = 0;
+    vetor_add(apr, -1); // Posição do literal UIP
+    int caminho = 0;    // Literais do nível atual ainda não resolvidos
+    int p = -1;
+    int idx = S->topo - 1;
+
+    do {
+        int *lits = CL_LITS(S, confl);
+        int tam = CL_TAM(S, confl);
+        for (int j = (p == -1) ? 0 : 1; j < tam; j++){
+            int q = lits[j];
+            int v = VAR(q);
+            if (S->visto[v] || S->nivel[v] == 0){
+                continue;
+            }
+            S->visto[v] = true;
+            aumentar_atividade(S, v);
+            if (S->nivel[v] >= S->num_niveis){
+                caminho++;
+            }
+            else {
+                vetor_add(apr, q);
+            }
+        }
+        // Próximo literal marcado da trilha, de trás para frente
+        while (!S->visto[VAR(S->trilha[idx])]){
+            idx--;
+        }
+        p = S->trilha[idx--];
+        confl = S->razao[VAR(p)];
+        S->visto[VAR(p)] = false;
+        caminho--;
+    } while (caminho > 0);
+    apr->dados[0] = NEG(p);
+
+    // Minimização recursiva
+    S->limpar.tam = 0;
+    unsigned niveis = 0;
+    for (int i = 1; i < apr->tam; i++){
+        vetor_add(&S->limpar, apr->dados[i]);
+        niveis |= nivel_abstrato(S, VAR(apr->dados[i]));
+    }
+    int k = 1;
+    for (int i = 1; i < apr->tam; i++){
+        int l = apr->dados[i];
+        if (S->razao[VAR(l)] == -1 || !literal_redundante(S, l, niveis)){
+            apr->dados[k++] = l;
+        }
+    }
+    apr->tam = k;
+    for (int i = 0; i < S->limpar.tam; i++){
+        S->visto[VAR(S->limpar.dados[i])] = false;
+    }
+
+    // Nível de retorno: o maior nível entre os outros literais (vai para a posição 1)
+    if (apr->tam == 1){
+        return 0;
+    }
+    int max_i = 1;
+    for (int i = 2; i < apr->tam; i++){
+        if (S->nivel[VAR(apr->dados[i])] > S->nivel[VAR(apr->dados[max_i])]){
+            max_i = i;
+        }
+    }
+    int aux = apr->dados[1];
+    apr->dados[1] = apr->dados[max_i];
+    apr->dados[max_i] = aux;
+    return S->nivel[VAR(apr->dados[1])];
+}
+
+SAT_INTERNO int calcular_lbd (solver *S, int *lits, int tam){
+    S->carimbo_nivel++;
+    int lbd = 0;
+    for (int i = 0; i < tam; i++){
+        int nv = S->nivel[VAR(lits[i])];
+        if (S->marca_nivel[nv] != S->carimbo_nivel){
+            S->marca_nivel[nv] = S->carimbo_nivel;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+//------ Sequência de Luby: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ... --------
+SAT_INTERNO long luby (long i){
+    long tam = 1, seq = 0;
+    while (tam < i + 1){
+        seq++;
+        tam = 2 * tam + 1;
+    }
+    while (tam - 1 != i){
+        tam = (tam - 1) / 2;
+        seq--;
+        i = i % tam;
+    }
+    return 1L << seq;
+}
+
+SAT_INTERNO bool deve_reiniciar (solver *S){
+    if (S->op.politica_reinicio == REINICIO_GLUCOSE){
+        return S->conflitos_reinicio >= 50 && S->ema_rapida * 0.8 > S->ema_lenta;
+    }
+    return S->conflitos_reinicio >= luby(S->reinicios) * UNIDADE_LUBY;
+}
+
+//------ A cláusula é razão de alguma atribuição atual? (não pode ser apagada) --------
+SAT_INTERNO bool travada (solver *S, int c){
+    int l = CL_LITS(S, c)[0];
+    return S->valores[VAR(l)] != INDEFINIDO && S->razao[VAR(l)] == c && valor_lit(S, l) == VERDADEIRO;
+}
+
+//---- Candidata a remoção (chave de ordenação copiada da arena) ------
+typedef struct candidata{
+    int cref;
+    int lbd;
+    int tam;
+}candidata;
+
+SAT_INTERNO int comparar_lbd (const void *a, const void *b){
+    const candidata *x = (const candidata*)a, *y = (const candidata*)b;
+    if (x->lbd != y->lbd){
+        return y->lbd - x->lbd; // Maior LBD primeiro (são as piores)
+    }
+    return y->tam - x->tam;     // Empate: maior cláusula primeiro
+}
+
+//------ Compacta a arena: copia as cláusulas vivas e corrige razões e vigias --------
+SAT_INTERNO void compactar_arena (solver *S){
+    int *nova = (int*)malloc(S->arena_cap * sizeof(int));
+    int tam = 0;
+    vetor *listas[2] = {&S->originais, &S->aprendidas};
+    for (int t = 0; t < 2; t++){
+        vetor *v = listas[t];
+        int k = 0;
+        for (int i = 0; i < v->tam; i++){
+            int c = v->dados[i];
+            if (CL_INFO(S, c) & APAGADA){
+                continue;
+            }
+            int ocupa = CABECALHO + CL_TAM(S, c);
+            memcpy(&nova[tam], &S->arena[c], ocupa * sizeof(int));
+            S->arena[c + 1] = tam; // Endereço novo fica guardado na arena antiga
+            v->dados[k++] = tam;
+            tam += ocupa;
+        }
+        v->tam = k;
+    }
+    for (int i = 0; i < S->topo; i++){
+        int v = VAR(S->trilha[i]);
+        if (S->razao[v] >= 0){
+            S->razao[v] = S->arena[S->razao[v] + 1];
+        }
+    }
+    free(S->arena);
+    S->arena = nova;
+    S->arena_tam = tam;
+
+    // Os vigias são sempre as posições 0 e 1, então dá para refazer as listas do zero
+    for (int l = 0; l < 2 * S->num_vars; l++){
+        S->vigias[l].tam = 0;
+    }
+    for (int t = 0; t < 2; t++){
+        for (int i = 0; i < listas[t]->tam; i++){
+            int c = listas[t]->dados[i];
+            if (CL_TAM(S, c) >= 2){
+                vigiar(S, c);
+            }
+        }
+    }
+}
+
+//------ Apaga metade das aprendidas com pior LBD --------
+SAT_INTERNO void reduzir_aprendidas (solver *S){
+    candidata *cand = (candidata*)malloc((S->aprendidas.tam + 1) * sizeof(candidata));
+    int num = 0;
+    for (int i = 0; i < S->aprendidas.tam; i++){
+        int c = S->aprendidas.dados[i];
+        if (CL_LBD(S, c) > 2 && !travada(S, c)){ // Cláusulas "cola" (LBD <= 2) ficam
+            cand[num].cref = c;
+            cand[num].lbd = CL_LBD(S, c);
+            cand[num].tam = CL_TAM(S, c);
+            num++;
+        }
+    }
+    qsort(cand, num, sizeof(candidata), comparar_lbd);
+    for (int i = 0; i < num / 2; i++){
+        CL_INFO(S, cand[i].cref) |= APAGADA;
+    }
+    free(cand);
+    compactar_arena(S);
+    S->reducoes++;
+}
+
+//------ Portfólio: publica uma cláusula aprendida curta para as outras threads --------
+SAT_INTERNO void exportar (solver *S, int *lits, int tam, int lbd){
+    if (S->comp == NULL || tam > MAX_LITS_COMPARTILHADA || lbd > MAX_LBD_COMPARTILHADA){
+        return;
+    }
+    uint64_t idx = atomic_fetch_add(&S->comp->cabeca, 1);
+    entrada_compartilhada *e = &S->comp->buf[idx & (TAM_COMPARTILHADO - 1)];
+    uint64_t seq = atomic_load_explicit(&e->seq, memory_order_relaxed);
+    // Só escreve se ninguém estiver escrevendo na mesma entrada (seq par)
+    if ((seq & 1) || !atomic_compare_exchange_strong(&e->seq, &seq, 2 * idx + 1)){
+        return;
+    }
+    atomic_store_explicit(&e->origem, S->id, memory_order_relaxed);
+    atomic_store_explicit(&e->tam, tam, memory_order_relaxed);
+    atomic_store_explicit(&e->lbd, lbd, memory_order_relaxed);
+    for (int i = 0; i < tam; i++){
+        atomic_store_explicit(&e->lits[i], lits[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&e->seq, 2 * idx + 2, memory_order_release);
+}
+
+//------ Adiciona no nível 0 uma cláusula que veio de outra thread --------
+SAT_INTERNO void adicionar_importada (solver *S, int *lits, int tam, int lbd){
+    int k = 0;
+    for (int i = 0; i < tam; i++){
+        signed char v = valor_lit(S, lits[i]);
+        if (v == VERDADEIRO){ // Já satisfeita pelos fatos do nível 0
+            return;
+        }
+        if (v == INDEFINIDO){
+            lits[k++] = lits[i];
+        }
+    }
+    if (k == 0){ // Todos falsos: a fórmula é insatisfatível
+        S->inconsistente = true;
+        return;
+    }
+    int cref = guardar_clausula(S, lits, k, true, lbd < k ? lbd : k);
+    if (k == 1){
+        atribuir(S, lits[0], cref);
+    }
+    S->importadas++;
+}
+
+//------ Lê do buffer compartilhado o que as outras threads aprenderam (só no nível 0) --------
+SAT_INTERNO void importar (solver *S){
+    if (S->comp == NULL){
+        return;
+    }
+    uint64_t fim = atomic_load(&S->comp->cabeca);
+    uint64_t idx = S->lido;
+    if (fim - idx > TAM_COMPARTILHADO){ // O que ficou para trás já foi sobrescrito
+        idx = fim - TAM_COMPARTILHADO;
+    }
+    int lits[MAX_LITS_COMPARTILHADA];
+    for (; idx < fim && !S->inconsistente; idx++){
+        entrada_compartilhada *e = &S->comp->buf[idx & (TAM_COMPARTILHADO - 1)];
+        uint64_t seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+        if (seq != 2 * idx + 2){ // Ainda em escrita ou já sobrescrita
+            continue;
+        }
+        int origem = atomic_load_explicit(&e->origem, memory_order_relaxed);
+        int tam = atomic_load_explicit(&e->tam, memory_order_relaxed);
+        int lbd = atomic_load_explicit(&e->lbd, memory_order_relaxed);
+        if (tam < 1 || tam > MAX_LITS_COMPARTILHADA){
+            continue;
+        }
+        for (int i = 0; i < tam; i++){
+            lits[i] = atomic_load_explicit(&e->lits[i], memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&e->seq, memory_order_relaxed) != seq || origem == S->id){
+            continue; // Mudou durante a cópia, ou é nossa mesmo
+        }
+        adicionar_importada(S, lits, tam, lbd);
+    }
+    S->lido = fim;
+}
+
+SAT_INTERNO bool interrompido (solver *S){
+    return S->comp != NULL && atomic_load_explicit(&S->comp->vencedor, memory_order_relaxed) != 0;
+}
+
+//------ Define os literais supostos verdadeiros na próxima chamada de resolver --------
+// Cada suposição ocupa um nível de decisão próprio (níveis 1..tam), por isso lim e
+// marca_nivel precisam de espaço para as variáveis mais as suposições.
+SAT_INTERNO void definir_suposicoes (solver *S, int *lits, int tam){
+    S->suposicoes.tam = 0;
+    for (int i = 0; i < tam; i++){
+        vetor_add(&S->suposicoes, lits[i]);
+    }
+    if (S->num_vars + tam + 1 > S->cap_niveis){
+        S->cap_niveis = S->num_vars + tam + 1;
+        S->lim = (int*)realloc(S->lim, S->cap_niveis * sizeof(int));
+        free(S->marca_nivel);
+        S->marca_nivel = (int*)calloc(S->cap_niveis, sizeof(int));
+        S->carimbo_nivel = 0;
+    }
+}
+
+//------ Suposições responsáveis por p ter ficado falso (p é a suposição violada) --------
+// Como todos os níveis abaixo do atual são suposições, basta subir pelas razões na
+// trilha e guardar as decisões encontradas.
+SAT_INTERNO void analisar_final (solver *S, int p){
+    S->falhas.tam = 0;
+    vetor_add(&S->falhas, p);
+    if (S->num_niveis == 0){
+        return;
+    }
+    S->visto[VAR(p)] = true;
+    for (int i = S->topo - 1; i >= S->lim[0]; i--){
+        int v = VAR(S->trilha[i]);
+        if (!S->visto[v]){
+            continue;
+        }
+        if (S->razao[v] < 0){
+            vetor_add(&S->falhas, S->trilha[i]);
+        }
+        else {
+            int *lits = CL_LITS(S, S->razao[v]);
+            for (int j = 1; j < CL_TAM(S, S->razao[v]); j++){
+                if (S->nivel[VAR(lits[j])] > 0){
+                    S->visto[VAR(lits[j])] = true;
+                }
+            }
+        }
+        S->visto[v] = false;
+    }
+    S->visto[VAR(p)] = false;
+}
+
+//------ CDCL: propaga, aprende com o conflito e volta direto ao nível certo --------
+// Com suposições, RES_UNSAT quer dizer "insatisfatível com essas suposições"; a fórmula
+// em si só é insatisfatível quando S->inconsistente fica verdadeiro.
+SAT_INTERNO int resolver (solver *S){
+    retroceder(S, 0);
+    S->falhas.tam = 0;
+    importar(S);
+    while (true){
+        if (S->inconsistente){
+            return RES_UNSAT;
+        }
+        if (interrompido(S) || (S->limite_conflitos >= 0 && S->conflitos >= S->limite_conflitos)){
+            return RES_DESCONHECIDO;
+        }
+        int confl = propagar(S);
+        if (confl >= 0){
+            S->conflitos++;
+            S->conflitos_reinicio++;
+            if (S->num_niveis == 0){
+                S->inconsistente = true;
+                return RES_UNSAT;
+            }
+            int nivel_volta = analisar(S, confl);
+            int lbd = calcular_lbd(S, S->aprendida.dados, S->aprendida.tam);
+            S->ema_rapida += (lbd - S->ema_rapida) / 32.0;
+            S->ema_lenta += (lbd - S->ema_lenta) / 4096.0;
+            S->incremento /= DECAIMENTO;
+            exportar(S, S->aprendida.dados, S->aprendida.tam, lbd);
+
+            retroceder(S, nivel_volta);
+            int cref = guardar_clausula(S, S->aprendida.dados, S->aprendida.tam, true, lbd);
+            atribuir(S, S->aprendida.dados[0], cref); // A cláusula aprendida é unitária no nível de retorno
+            continue;
+        }
+        if (deve_reiniciar(S)){
+            S->reinicios++;
+            S->conflitos_reinicio = 0;
+            retroceder(S, 0);
+            importar(S);
+            continue; // Propaga o que foi importado antes de decidir
+        }
+        if (S->conflitos >= S->prox_reducao){
+            reduzir_aprendidas(S);
+            S->prox_reducao = S->conflitos + REDUCAO_INICIAL + REDUCAO_PASSO * S->reducoes;
+        }
+        int lit = -1;
+        while (S->num_niveis < S->suposicoes.tam){ // Primeiro as suposições, uma por nível
+            int p = S->suposicoes.dados[S->num_niveis];
+            signed char v = valor_lit(S, p);
+            if (v == VERDADEIRO){ // Já vale: abre um nível vazio para manter nível = suposição
+                novo_nivel(S);
+            }
+            else if (v == FALSO){ // Os fatos e as outras suposições contradizem esta
+                analisar_final(S, p);
+                return RES_UNSAT;
+            }
+            else {
+                lit = p;
+                break;
+            }
+        }
+        if (lit < 0){
+            lit = escolher_literal(S);
+        }
+        if (lit < 0){ // Tudo atribuído sem conflito
+            return RES_SAT;
+        }
+        S->decisoes++;
+        novo_nivel(S);
+        atribuir(S, lit, -1);
+    }
+}
+
+SAT_INTERNO bool SAT_SOLVER (formula *F, bool *interpretacoes, opcoes *op){
+    solver *S = criar_solver(F, op);
+    bool sat = (resolver(S) == RES_SAT);
+    if (sat){
+        for (int i = 0; i < F->num_variaveis; i++){
+            interpretacoes[i] = (S->valores[i] == VERDADEIRO);
+        }
+    }
+    liberar_solver(S);
+    return sat;
+}
+
+//------ Opções padrão (as mesmas da linha de comando sem argumentos) --------
+SAT_INTERNO void opcoes_padrao (opcoes *op){
+    op->heuristica = HEURISTICA_VSIDS;
+    op->politica_reinicio = REINICIO_LUBY;
+    op->salvar_fase = true;
+    op->fase_inicial = true; // Como na busca original: TRUE primeiro
+    op->modo = MODO_CDCL;
+    op->threads = 1;
+    op->portfolio = 1;
+    op->cubos = 0;
+    op->profundidade = 0;
+    op->simplificar = true;
+    op->semente = 0;
+    op->freq_aleatoria = 0;
+}
+
+//=================== INTERFACE INCREMENTAL (sat.h) ===================
+// O solver fica vivo entre as consultas: cláusulas aprendidas, atividades e fases são
+// reaproveitadas. Todas as funções trabalham no nível 0, entre duas buscas.
+
+//------ Aumenta os vetores indexados por variável para n variáveis --------
+SAT_INTERNO void garantir_variaveis (solver *S, int n){
+    if (n <= S->num_vars){
+        return;
+    }
+    if (n > S->cap_vars){
+        int cap = S->cap_vars ? S->cap_vars : 16;
+        while (cap < n){
+            cap *= 2;
+        }
+        int antiga = S->cap_vars;
+        S->vigias = (lista_vigias*)realloc(S->vigias, 2 * cap * sizeof(lista_vigias));
+        memset(S->vigias + 2 * antiga, 0, 2 * (cap - antiga) * sizeof(lista_vigias));
+        S->marca = (int*)realloc(S->marca, 2 * cap * sizeof(int));
+        memset(S->marca + 2 * antiga, 0, 2 * (cap - antiga) * sizeof(int));
+        S->visto = (bool*)realloc(S->visto, cap * sizeof(bool));
+        memset(S->visto + antiga, 0, (cap - antiga) * sizeof(bool));
+        S->valores = (signed char*)realloc(S->valores, cap * sizeof(signed char));
+        S->nivel = (int*)realloc(S->nivel, cap * sizeof(int));
+        S->razao = (int*)realloc(S->razao, cap * sizeof(int));
+        S->trilha = (int*)realloc(S->trilha, cap * sizeof(int));
+        S->atividade = (double*)realloc(S->atividade, cap * sizeof(double));
+        S->heap = (int*)realloc(S->heap, cap * sizeof(int));
+        S->pos_heap = (int*)realloc(S->pos_heap, cap * sizeof(int));
+        S->fase = (bool*)realloc(S->fase, cap * sizeof(bool));
+        S->cap_vars = cap;
+    }
+    for (int v = S->num_vars; v < n; v++){
+        S->valores[v] = INDEFINIDO;
+        S->atividade[v] = 0;
+        S->fase[v] = S->op.fase_inicial;
+        S->pos_heap[v] = -1;
+        heap_inserir(S, v);
+    }
+    S->num_vars = n;
+    if (n + S->suposicoes.tam + 1 > S->cap_niveis){
+        S->cap_niveis = 2 * (n + S->suposicoes.tam + 1);
+        S->lim = (int*)realloc(S->lim, S->cap_niveis * sizeof(int));
+        free(S->marca_nivel);
+        S->marca_nivel = (int*)calloc(S->cap_niveis, sizeof(int));
+        S->carimbo_nivel = 0;
+    }
+}
+
+solver *sat_novo (void){
+    formula F;
+    opcoes op;
+    iniciar_formula(&F);
+    opcoes_padrao(&op);
+    solver *S = criar_solver(&F, &op);
+    liberar_formula(&F);
+    return S;
+}
+
+void sat_liberar (solver *S){
+    liberar_solver(S);
+}
+
+int sat_nova_variavel (solver *S){
+    garantir_variaveis(S, S->num_vars + 1);
+    return S->num_vars;
+}
+
+bool sat_adicionar (solver *S, const int *lits, int tam){
+    retroceder(S, 0);
+    vetor c = {NULL, 0, 0};
+    for (int i = 0; i < tam && lits[i] != 0; i++){ // 0 termina a cláusula, como no DIMACS
+        garantir_variaveis(S, abs(lits[i]));
+        vetor_add(&c, LIT(lits[i]));
+    }
+    if (S->escopos.tam > 0){ // Só vale enquanto o escopo estiver ativo
+        vetor_add(&c, NEG(S->escopos.dados[S->escopos.tam - 1]));
+    }
+    adicionar_clausula(S, c.dados, c.tam);
+    free(c.dados);
+    return !S->inconsistente;
+}
+
+int sat_resolver (solver *S, const int *suposicoes, int tam, long limite_conflitos){
+    vetor sup = {NULL, 0, 0};
+    for (int i = 0; i < S->escopos.tam; i++){
+        vetor_add(&sup, S->escopos.dados[i]);
+    }
+    for (int i = 0; i < tam && suposicoes[i] != 0; i++){ // 0 termina a lista, como no DIMACS
+        garantir_variaveis(S, abs(suposicoes[i]));
+        vetor_add(&sup, LIT(suposicoes[i]));
+    }
+    definir_suposicoes(S, sup.dados, sup.tam);
+    free(sup.dados);
+    S->limite_conflitos = (limite_conflitos < 0) ? -1 : S->conflitos + limite_conflitos;
+    int r = resolver(S);
+    if (r == RES_SAT){
+        free(S->modelo);
+        S->modelo = (signed char*)malloc((S->num_vars + 1) * sizeof(signed char));
+        memcpy(S->modelo, S->valores, S->num_vars * sizeof(signed char));
+        S->modelo[S->num_vars] = 0; // Só para o malloc nunca ser de 0 bytes
+        S->tam_modelo = S->num_vars;
+    }
+    S->limite_conflitos = -1;
+    return r;
+}
+
+int sat_valor (solver *S, int lit){
+    int v = abs(lit) - 1;
+    if (S->modelo == NULL || v < 0 || v >= S->tam_modelo || S->modelo[v] == INDEFINIDO){ // Variável posterior ao modelo
+        return INDEFINIDO;
+    }
+    return (lit > 0) ? S->modelo[v] : !S->modelo[v];
+}
+
+void sat_estatisticas (solver *S, long *decisoes, long *propagacoes, long *conflitos){
+    *decisoes = S->decisoes;
+    *propagacoes = S->propagacoes;
+    *conflitos = S->conflitos;
+}
+
+bool sat_falhou (solver *S, int lit){
+    if (lit == 0){ // Não é literal
+        return false;
+    }
+    int l = LIT(lit);
+    for (int i = 0; i < S->falhas.tam; i++){
+        if (S->falhas.dados[i] == l){
+            return true;
+        }
+    }
+    return false;
+}
+
+void sat_empurrar (solver *S){
+    int a = sat_nova_variavel(S);
+    vetor_add(&S->escopos, LIT(a));
+}
+
+void sat_retirar (solver *S){
+    if (S->escopos.tam == 0){
+        return;
+    }
+    retroceder(S, 0);
+    int desliga = NEG(S->escopos.dados[--S->escopos.tam]);
+    adicionar_clausula(S, &desliga, 1); // Fato do nível 0: as cláusulas do escopo ficam satisfeitas
+}
+
+//=================== PORTFÓLIO PARALELO ===================
+// Várias configurações diferentes atacam a mesma fórmula; a primeira que responde vence
+// e as outras param no próximo passo da busca.
+typedef struct tarefa_portfolio{
+    formula *F;
+    opcoes op;
+    compartilhado *comp;
+    int id;
+    int resultado;
+    bool *interpretacoes; // Só a vencedora escreve
+    long conflitos;
+    long importadas;
+}tarefa_portfolio;
+
+SAT_INTERNO void *rodar_portfolio (void *arg){
+    tarefa_portfolio *t = (tarefa_portfolio*)arg;
+    solver *S = criar_solver(t->F, &t->op);
+    S->comp = t->comp;
+    S->id = t->id;
+    t->resultado = resolver(S);
+    int ninguem = 0;
+    if (t->resultado != RES_DESCONHECIDO && atomic_compare_exchange_strong(&t->comp->vencedor, &ninguem, t->id + 1)){
+        if (t->resultado == RES_SAT){
+            for (int i = 0; i < t->F->num_variaveis; i++){
+                t->interpretacoes[i] = (S->valores[i] == VERDADEIRO);
+            }
+        }
+    }
+    t->conflitos = S->conflitos;
+    t->importadas = S->importadas;
+    liberar_solver(S);
+    return NULL;
+}
+
+//------ Diversifica as opções da thread i a partir das opções do usuário --------
+SAT_INTERNO opcoes configuracao_portfolio (opcoes *base, int i){
+    opcoes op = *base;
+    if (i == 0){ // A primeira roda exatamente o que foi pedido
+        return op;
+    }
+    op.semente = base->semente + i;
+    op.politica_reinicio = (i % 2) ? REINICIO_GLUCOSE : REINICIO_LUBY;
+    op.fase_inicial = ((i / 2) % 2) ? !base->fase_inicial : base->fase_inicial;
+    op.salvar_fase = (i % 7 != 3);
+    op.freq_aleatoria = 0.01 * (i % 4);
+    return op;
+}
+
+SAT_INTERNO bool portfolio (formula *F, bool *interpretacoes, opcoes *op){
+    int n = op->portfolio;
+    compartilhado *comp = (compartilhado*)calloc(1, sizeof(compartilhado));
+    tarefa_portfolio *t = (tarefa_portfolio*)calloc(n, sizeof(tarefa_portfolio));
+    pthread_t *th = (pthread_t*)malloc(n * sizeof(pthread_t));
+    for (int i = 0; i < n; i++){
+        t[i].F = F;
+        t[i].op = configuracao_portfolio(op, i);
+        t[i].comp = comp;
+        t[i].id = i;
+        t[i].interpretacoes = interpretacoes;
+        pthread_create(&th[i], NULL, rodar_portfolio, &t[i]);
+    }
+    long importadas = 0;
+    for (int i = 0; i < n; i++){
+        pthread_join(th[i], NULL);
+        importadas += t[i].importadas;
+    }
+    int v = atomic_load(&comp->vencedor) - 1;
+    printf("c portfolio: thread %d respondeu apos %ld conflitos; %llu clausulas publicadas, %ld importadas\n",
+           v, t[v].conflitos, (unsigned long long)atomic_load(&comp->cabeca), importadas);
+    bool sat = (t[v].resultado == RES_SAT);
+    free(t); free(th); free(comp);
+    return sat;
+}
+
+//=================== CUBO-E-CONQUISTA ===================
+// Um lookahead raso divide a fórmula em cubos (atribuições parciais). Cada thread resolve
+// cubos sob suposições com um limite de conflitos; quando estoura o limite e há alguém
+// ocioso, o cubo é dividido em dois e os pedaços ficam disponíveis para roubo.
+#define CANDIDATOS_LOOKAHEAD 64  // Variáveis mais frequentes testadas em cada nó
+#define ORCAMENTO_CUBO 1000      // Conflitos por cubo antes de tentar dividir
+
+typedef struct cubo{
+    int tam;
+    long orcamento;
+    int lits[];
+}cubo;
+
+//------ Fila dupla de cada thread: o dono usa o fim, os ladrões pegam do início --------
+typedef struct deque_cubos{
+    pthread_mutex_t trava;
+    cubo **itens;
+    int inicio, fim, cap;
+}deque_cubos;
+
+typedef struct pool_cubos{
+    deque_cubos *filas;
+    int num_filas;
+    atomic_int pendentes; // Cubos ainda não refutados (na fila ou sendo resolvidos)
+    atomic_int ociosos;   // Threads procurando trabalho
+    compartilhado comp;   // Parada e troca de cláusulas, como no portfólio
+}pool_cubos;
+
+SAT_INTERNO cubo *novo_cubo (int *lits, int tam, long orcamento){
+    cubo *c = (cubo*)malloc(sizeof(cubo) + tam * sizeof(int));
+    c->tam = tam;
+    c->orcamento = orcamento;
+    memcpy(c->lits, lits, tam * sizeof(int));
+    return c;
+}
+
+SAT_INTERNO cubo *estender_cubo (cubo *c, int lit){
+    cubo *filho = (cubo*)malloc(sizeof(cubo) + (c->tam + 1) * sizeof(int));
+    filho->tam = c->tam + 1;
+    filho->orcamento = c->orcamento;
+    memcpy(filho->lits, c->lits, c->tam * sizeof(int));
+    filho->lits[c->tam] = lit;
+    return filho;
+}
+
+SAT_INTERNO void empilhar_cubo (deque_cubos *d, cubo *c){
+    pthread_mutex_lock(&d->trava);
+    if (d->inicio > 0 && d->inicio == d->fim){
+        d->inicio = d->fim = 0;
+    }
+    if (d->fim == d->cap){
+        d->cap = d->cap ? 2 * d->cap : 16;
+        d->itens = (cubo**)realloc(d->itens, d->cap * sizeof(cubo*));
+    }
+    d->itens[d->fim++] = c;
+    pthread_mutex_unlock(&d->trava);
+}
+
+SAT_INTERNO cubo *desempilhar_cubo (deque_cubos *d, bool do_inicio){
+    cubo *c = NULL;
+    pthread_mutex_lock(&d->trava);
+    if (d->inicio < d->fim){
+        c = do_inicio ? d->itens[d->inicio++] : d->itens[--d->fim];
+    }
+    pthread_mutex_unlock(&d->trava);
+    return c;
+}
+
+//------ Escolhe a variável de divisão: a que mais propaga nos dois sentidos --------
+// Devolve -1 se tudo já está atribuído ou se o nó atual é contraditório (*refutado).
+SAT_INTERNO int escolher_lookahead (solver *S, int *por_ocorrencia, bool *refutado){
+    *refutado = false;
+    int melhor = -1;
+    long melhor_nota = -1;
+    int testadas = 0;
+    for (int i = 0; i < S->num_vars && testadas < CANDIDATOS_LOOKAHEAD; i++){
+        int v = por_ocorrencia[i];
+        if (S->valores[v] != INDEFINIDO){
+            continue;
+        }
+        testadas++;
+        long propagadas[2];
+        bool falhou[2];
+        for (int s = 0; s < 2; s++){
+            int antes = S->topo;
+            novo_nivel(S);
+            atribuir(S, 2 * v + s, -1);
+            falhou[s] = (propagar(S) >= 0);
+            propagadas[s] = S->topo - antes;
+            retroceder(S, S->num_niveis - 1);
+        }
+        if (falhou[0] && falhou[1]){
+            *refutado = true;
+            return -1;
+        }
+        if (falhou[0] || falhou[1]){ // Literal que falha: um dos lados já morre, divide aqui
+            return v;
+        }
+        long nota = (propagadas[0] + 1) * (propagadas[1] + 1);
+        if (nota > melhor_nota){
+            melhor_nota = nota;
+            melhor = v;
+        }
+    }
+    return melhor;
+}
+
+//------ Gera os cubos até a profundidade pedida, descartando os refutados --------
+SAT_INTERNO void dividir (solver *S, int *por_ocorrencia, vetor *caminho, int profundidade, pool_cubos *P, int *gerados){
+    bool refutado = false;
+    int v = (profundidade > 0) ? escolher_lookahead(S, por_ocorrencia, &refutado) : -1;
+    if (refutado){
+        return;
+    }
+    if (v < 0){
+        empilhar_cubo(&P->filas[*gerados % P->num_filas], novo_cubo(caminho->dados, caminho->tam, ORCAMENTO_CUBO));
+        atomic_fetch_add(&P->pendentes, 1);
+        (*gerados)++;
+        return;
+    }
+    for (int s = 0; s < 2; s++){
+        int nivel = S->num_niveis;
+        novo_nivel(S);
+        atribuir(S, 2 * v + s, -1);
+        if (propagar(S) < 0){
+            vetor_add(caminho, 2 * v + s);
+            dividir(S, por_ocorrencia, caminho, profundidade - 1, P, gerados);
+            caminho->tam--;
+        }
+        retroceder(S, nivel);
+    }
+}
+
+typedef struct tarefa_cubo{
+    formula *F;
+    opcoes op;
+    pool_cubos *P;
+    int id;
+    int resultado;
+    bool *interpretacoes; // Só a vencedora escreve
+    long resolvidos, divisoes, roubos, conflitos;
+}tarefa_cubo;
+
+SAT_INTERNO cubo *pegar_cubo (tarefa_cubo *t){
+    pool_cubos *P = t->P;
+    cubo *c = desempilhar_cubo(&P->filas[t->id], false);
+    if (c != NULL){
+        return c;
+    }
+    atomic_fetch_add(&P->ociosos, 1);
+    while (c == NULL && atomic_load(&P->pendentes) > 0 && atomic_load(&P->comp.vencedor) == 0){
+        for (int k = 1; k < P->num_filas && c == NULL; k++){
+            c = desempilhar_cubo(&P->filas[(t->id + k) % P->num_filas], true);
+        }
+        if (c != NULL){
+            t->roubos++;
+        }
+        else {
+            sched_yield();
+        }
+    }
+    atomic_fetch_sub(&P->ociosos, 1);
+    return c;
+}
+
+//------ Variável livre de maior atividade que ainda não está no cubo --------
+SAT_INTERNO int variavel_divisao (solver *S, cubo *c){
+    int melhor = -1;
+    for (int v = 0; v < S->num_vars; v++){
+        if (S->valores[v] != INDEFINIDO || (melhor >= 0 && S->atividade[v] <= S->atividade[melhor])){
+            continue;
+        }
+        bool no_cubo = false;
+        for (int i = 0; i < c->tam && !no_cubo; i++){
+            no_cubo = (VAR(c->lits[i]) == v);
+        }
+        if (!no_cubo){
+            melhor = v;
+        }
+    }
+    return melhor;
+}
+
+SAT_INTERNO void vencer (tarefa_cubo *t, solver *S, int resultado){
+    int ninguem = 0;
+    if (atomic_compare_exchange_strong(&t->P->comp.vencedor, &ninguem, t->id + 1)){
+        t->resultado = resultado;
+        if (resultado == RES_SAT){
+            for (int i = 0; i < t->F->num_variaveis; i++){
+                t->interpretacoes[i] = (S->valores[i] == VERDADEIRO);
+            }
+        }
+    }
+}
+
+SAT_INTERNO void *rodar_cubos (void *arg){
+    tarefa_cubo *t = (tarefa_cubo*)arg;
+    pool_cubos *P = t->P;
+    solver *S = criar_solver(t->F, &t->op);
+    S->comp = &P->comp;
+    S->id = t->id;
+    cubo *c;
+    while ((c = pegar_cubo(t)) != NULL){
+        definir_suposicoes(S, c->lits, c->tam);
+        S->limite_conflitos = S->conflitos + c->orcamento;
+        int r = resolver(S);
+        if (r == RES_SAT){
+            vencer(t, S, RES_SAT);
+        }
+        else if (r == RES_UNSAT && S->inconsistente){ // Contradição sem depender do cubo
+            vencer(t, S, RES_UNSAT);
+        }
+        else if (r == RES_UNSAT){
+            t->resolvidos++;
+            atomic_fetch_sub(&P->pendentes, 1);
+        }
+        else if (!interrompido(S)){ // Estourou o limite: divide se alguém está parado
+            retroceder(S, 0);
+            int v = (atomic_load(&P->ociosos) > 0) ? variavel_divisao(S, c) : -1;
+            if (v >= 0){
+                atomic_fetch_add(&P->pendentes, 1);
+                empilhar_cubo(&P->filas[t->id], estender_cubo(c, 2 * v + 1));
+                empilhar_cubo(&P->filas[t->id], estender_cubo(c, 2 * v));
+                t->divisoes++;
+            }
+            else {
+                cubo *mesmo = novo_cubo(c->lits, c->tam, 2 * c->orcamento);
+                empilhar_cubo(&P->filas[t->id], mesmo);
+            }
+        }
+        free(c);
+    }
+    t->conflitos = S->conflitos;
+    liberar_solver(S);
+    return NULL;
+}
+
+SAT_INTERNO bool cubo_e_conquista (formula *F, bool *interpretacoes, opcoes *op, int profundidade){
+    int n = op->cubos;
+    pool_cubos *P = (pool_cubos*)calloc(1, sizeof(pool_cubos));
+    P->num_filas = n;
+    P->filas = (deque_cubos*)calloc(n, sizeof(deque_cubos));
+    for (int i = 0; i < n; i++){
+        pthread_mutex_init(&P->filas[i].trava, NULL);
+    }
+    // Ordem dos candidatos do lookahead: variáveis que aparecem em mais cláusulas primeiro
+    solver *S = criar_solver(F, op);
+    int *ocorrencias = (int*)calloc(F->num_variaveis, sizeof(int));
+    int *por_ocorrencia = (int*)malloc(F->num_variaveis * sizeof(int));
+    for (int i = 0; i < F->num_literais; i++){
+        ocorrencias[abs(F->literais[i]) - 1]++;
+    }
+    for (int v = 0; v < F->num_variaveis; v++){ // Insertion sort estável; roda uma vez só
+        int j = v;
+        while (j > 0 && ocorrencias[por_ocorrencia[j - 1]] < ocorrencias[v]){
+            por_ocorrencia[j] = por_ocorrencia[j - 1];
+            j--;
+        }
+        por_ocorrencia[j] = v;
+    }
+    clock_t inicio = clock();
+    int gerados = 0;
+    vetor caminho = {NULL, 0, 0};
+    if (!S->inconsistente && propagar(S) < 0){
+        dividir(S, por_ocorrencia, &caminho, profundidade, P, &gerados);
+    }
+    printf("c cubos: %d gerados com profundidade %d em %.2fs\n", gerados, profundidade,
+           (double)(clock() - inicio) / CLOCKS_PER_SEC);
+    free(caminho.dados); free(ocorrencias); free(por_ocorrencia);
+    liberar_solver(S);
+
+    tarefa_cubo *t = (tarefa_cubo*)calloc(n, sizeof(tarefa_cubo));
+    pthread_t *th = (pthread_t*)malloc(n * sizeof(pthread_t));
+    for (int i = 0; i < n; i++){
+        t[i].F = F;
+        t[i].op = configuracao_portfolio(op, i);
+        t[i].op.freq_aleatoria = 0; // Só a semente muda; a divisão já diversifica
+        t[i].P = P;
+        t[i].id = i;
+        t[i].resultado = RES_UNSAT;
+        t[i].interpretacoes = interpretacoes;
+        pthread_create(&th[i], NULL, rodar_cubos, &t[i]);
+    }
+    long resolvidos = 0, divisoes = 0, roubos = 0, conflitos = 0;
+    for (int i = 0; i < n; i++){
+        pthread_join(th[i], NULL);
+        resolvidos += t[i].resolvidos;
+        divisoes += t[i].divisoes;
+        roubos += t[i].roubos;
+        conflitos += t[i].conflitos;
+    }
+    int v = atomic_load(&P->comp.vencedor) - 1;
+    bool sat = (v >= 0 && t[v].resultado == RES_SAT);
+    printf("c cubos: %ld refutados, %ld divisoes, %ld roubos, %ld conflitos no total\n",
+           resolvidos, divisoes, roubos, conflitos);
+    for (int i = 0; i < n; i++){
+        cubo *c;
+        while ((c = desempilhar_cubo(&P->filas[i], false)) != NULL){
+            free(c);
+        }
+        free(P->filas[i].itens);
+        pthread_mutex_destroy(&P->filas[i].trava);
+    }
+    free(t); free(th); free(P->filas); free(P);
+    return sat;
+}
+
+//=================== AVALIAÇÃO EXAUSTIVA BIT-PARALELA ===================
+// Para fórmulas pequenas: testa todas as 2^n interpretações, 256 de cada vez.
+// A interpretação a tem o bit v igual ao valor de x(v+1). Um bloco cobre
+// a = 256 * b ... 256 * b + 255: as variáveis 0..7 variam dentro do bloco
+// (máscaras fixas) e as demais são constantes no bloco inteiro.
+#define MAX_VARS_EXAUSTIVO 62
+#define VARS_NO_BLOCO 8
+
+typedef uint64_t bloco256 __attribute__((vector_size(32))); // 4 palavras; vira AVX2 com -mavx2
+
+typedef struct tarefa_exaustiva{
+    formula *F;
+    int *vars;            // Variável (0..n-1) de cada literal da fórmula
+    bool *negado;         // Se o literal é negado
+    uint64_t inicio;      // Blocos [inicio, fim) desta thread
+    uint64_t fim;
+    int modo;
+    uint64_t modelos;     // Quantos modelos esta thread achou
+    uint64_t primeiro;    // Um modelo (quando modelos > 0)
+    _Atomic bool *parar;  // Alguma thread já achou um modelo (modo SAT/UNSAT)
+    pthread_mutex_t *saida;
+}tarefa_exaustiva;
+
+// Máscaras das variáveis 0..7 dentro do bloco
+SAT_INTERNO void mascaras_fixas (bloco256 *m){
+    const uint64_t padrao[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+                                0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+    for (int v = 0; v < 6; v++){
+        for (int w = 0; w < 4; w++){
+            m[v][w] = padrao[v];
+        }
+    }
+    for (int w = 0; w < 4; w++){ // Variáveis 6 e 7 escolhem a palavra
+        m[6][w] = (w & 1) ? ~0ULL : 0;
+        m[7][w] = (w & 2) ? ~0ULL : 0;
+    }
+}
+
+SAT_INTERNO void imprimir_modelo (uint64_t a, int n){
+    printf("v");
+    for (int v = 0; v < n; v++){
+        printf(" %d", ((a >> v) & 1) ? v + 1 : -(v + 1));
+    }
+    printf(" 0\n");
+}
+
+SAT_INTERNO void *avaliar_blocos (void *arg){
+    tarefa_exaustiva *t = (tarefa_exaustiva*)arg;
+    formula *F = t->F;
+    int n = F->num_variaveis;
+    bloco256 *m = (bloco256*)aligned_alloc(32, (n + VARS_NO_BLOCO) * sizeof(bloco256));
+    bloco256 zero = {0, 0, 0, 0};
+    bloco256 validas = ~zero;
+    mascaras_fixas(m);
+    if (n < VARS_NO_BLOCO){ // Só as primeiras 2^n posições do bloco existem
+        for (int w = 0; w < 4; w++){
+            int primeira = 64 * w;
+            uint64_t total = (1ULL << n);
+            if (primeira >= (int)total) validas[w] = 0;
+            else if (total - primeira < 64) validas[w] = (1ULL << (total - primeira)) - 1;
+        }
+    }
+
+    for (uint64_t b = t->inicio; b < t->fim; b++){
+        if (t->modo == MODO_EXAUSTIVO && *t->parar){
+            break;
+        }
+        for (int v = VARS_NO_BLOCO; v < n; v++){
+            uint64_t bit = (b >> (v - VARS_NO_BLOCO)) & 1;
+            bloco256 c = {-bit, -bit, -bit, -bit};
+            m[v] = c;
+        }
+        bloco256 res = validas;
+        for (int c = 0; c < F->num_clausulas; c++){
+            bloco256 cl = zero;
+            for (int i = F->inicio[c]; i < F->inicio[c + 1]; i++){
+                cl |= t->negado[i] ? ~m[t->vars[i]] : m[t->vars[i]];
+            }
+            res &= cl;
+            if ((res[0] | res[1] | res[2] | res[3]) == 0){ // Nenhuma das 256 satisfaz: próximo bloco
+                break;
+            }
+        }
+        for (int w = 0; w < 4; w++){
+            uint64_t bits = res[w];
+            if (bits == 0){
+                continue;
+            }
+            if (t->modelos == 0){
+                t->primeiro = 256 * b + 64 * w + __builtin_ctzll(bits);
+            }
+            t->modelos += __builtin_popcountll(bits);
+            if (t->modo == MODO_EXAUSTIVO){
+                *t->parar = true;
+            }
+            if (t->modo == MODO_ENUMERAR){
+                pthread_mutex_lock(t->saida);
+                while (bits){
+                    imprimir_modelo(256 * b + 64 * w + __builtin_ctzll(bits), n);
+                    bits &= bits - 1;
+                }
+                pthread_mutex_unlock(t->saida);
+            }
+        }
+    }
+    free(m);
+    return NULL;
+}
+
+//------ Testa todas as interpretações com várias threads; retorna o número de modelos --------
+// No MODO_EXAUSTIVO para no primeiro bloco com modelo (a contagem não é completa).
+SAT_INTERNO uint64_t exaustivo (formula *F, int modo, int num_threads, bool *interpretacoes){
+    int n = F->num_variaveis;
+    uint64_t blocos = (n > VARS_NO_BLOCO) ? (1ULL << (n - VARS_NO_BLOCO)) : 1;
+    if ((uint64_t)num_threads > blocos){
+        num_threads = (int)blocos;
+    }
+    int *vars = (int*)malloc((F->num_literais + 1) * sizeof(int));
+    bool *negado = (bool*)malloc((F->num_literais + 1) * sizeof(bool));
+    for (int i = 0; i < F->num_literais; i++){
+        vars[i] = abs(F->literais[i]) - 1;
+        negado[i] = F->literais[i] < 0;
+    }
+
+    _Atomic bool parar = false;
+    pthread_mutex_t saida = PTHREAD_MUTEX_INITIALIZER;
+    tarefa_exaustiva *t = (tarefa_exaustiva*)calloc(num_threads, sizeof(tarefa_exaustiva));
+    pthread_t *th = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    for (int i = 0; i < num_threads; i++){
+        t[i].F = F;
+        t[i].vars = vars;
+        t[i].negado = negado;
+        t[i].inicio = blocos * i / num_threads;
+        t[i].fim = blocos * (i + 1) / num_threads;
+        t[i].modo = modo;
+        t[i].parar = &parar;
+        t[i].saida = &saida;
+        pthread_create(&th[i], NULL, avaliar_blocos, &t[i]);
+    }
+    uint64_t total = 0;
+    bool achou = false;
+    for (int i = 0; i < num_threads; i++){
+        pthread_join(th[i], NULL);
+        total += t[i].modelos;
+        if (t[i].modelos > 0 && !achou){
+            achou = true;
+            for (int v = 0; v < n; v++){
+                interpretacoes[v] = (t[i].primeiro >> v) & 1;
+            }
+        }
+    }
+    free(t); free(th); free(vars); free(negado);
+    return total;
+}
+#ifndef SAT_BIBLIOTECA
+//------ Completa o modelo da fórmula simplificada e confere contra a original --------
+bool modelo_original (formula *F, vetor *pilha, bool *interpretacoes){
+    reconstruir(pilha, interpretacoes);
+    return eh_sat(F, interpretacoes);
+}
+
+//------ Modelo que não satisfaz a original é erro do pré-processamento ou da busca, nunca UNSAT --------
+void modelo_invalido (void){
+    printf("Erro: o modelo encontrado nao satisfaz a formula original.\n");
+}
+
+void solucao (bool *interpretacao, int num_var){
+    printf("SAT !\n");
+    printf("Solucoes :\n");
+    for (int i = 0; i < num_var; i++){
+        printf("x%d = %s\n", i + 1, interpretacao[i] ? "TRUE" : "FALSE");
+    }
+}
+//------ Lê as opções da linha de comando; retorna o caminho do arquivo (ou NULL) --------
+bool ler_opcoes (int argc, char *argv[], opcoes *op, const char **caminho){
+    opcoes_padrao(op);
+    *caminho = NULL;
+    for (int i = 1; i < argc; i++){
+        if (strcmp(argv[i], "--heuristica=vsids") == 0) op->heuristica = HEURISTICA_VSIDS;
+        else if (strcmp(argv[i], "--heuristica=ordem") == 0) op->heuristica = HEURISTICA_ORDEM;
+        else if (strcmp(argv[i], "--reinicio=luby") == 0) op->politica_reinicio = REINICIO_LUBY;
+        else if (strcmp(argv[i], "--reinicio=glucose") == 0) op->politica_reinicio = REINICIO_GLUCOSE;
+        else if (strcmp(argv[i], "--sem-fase") == 0) op->salvar_fase = false;
+        else if (strcmp(argv[i], "--fase=falso") == 0) op->fase_inicial = false;
+        else if (strcmp(argv[i], "--fase=verdadeiro") == 0) op->fase_inicial = true;
+        else if (strcmp(argv[i], "--sem-simplificar") == 0) op->simplificar = false;
+        else if (strcmp(argv[i], "--exaustivo") == 0) op->modo = MODO_EXAUSTIVO;
+        else if (strcmp(argv[i], "--contar") == 0) op->modo = MODO_CONTAR;
+        else if (strcmp(argv[i], "--enumerar") == 0) op->modo = MODO_ENUMERAR;
+        else if (strcmp(argv[i], "--conferir") == 0) op->modo = MODO_CONFERIR;
+        else if (strncmp(argv[i], "--threads=", 10) == 0 && atoi(argv[i] + 10) > 0) op->threads = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--portfolio=", 12) == 0 && atoi(argv[i] + 12) > 0) op->portfolio = atoi(argv[i] + 12);
+        else if (strncmp(argv[i], "--cubos=", 8) == 0 && atoi(argv[i] + 8) > 0) op->cubos = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--profundidade=", 15) == 0 && atoi(argv[i] + 15) > 0) op->profundidade = atoi(argv[i] + 15);
+        else if (strncmp(argv[i], "--semente=", 10) == 0) op->semente = strtoull(argv[i] + 10, NULL, 10);
+        else if (argv[i][0] == '-' && argv[i][1] == '-') return false;
+        else if (*caminho == NULL) *caminho = argv[i];
+        else return false;
+    }
+    return true;
+}
+int main (int argc, char *argv[]){
+    opcoes op;
+    const char *caminho;
+    if (!ler_opcoes(argc, argv, &op, &caminho)){
+        printf("Uso: %s [opcoes] [arquivo.cnf | arquivo.cnf.gz | -]\n", argv[0]);
+        printf("  --heuristica=vsids|ordem   escolha da variavel de decisao (padrao: vsids)\n");
+        printf("  --reinicio=luby|glucose    politica de reinicio (padrao: luby)\n");
+        printf("  --sem-fase                 nao repete o ultimo valor da variavel\n");
+        printf("  --fase=verdadeiro|falso    valor tentado primeiro (padrao: verdadeiro)\n");
+        printf("  --sem-simplificar          busca direto na formula lida, sem pre-processamento\n");
+        printf("  --exaustivo                forca bruta bit-paralela (ate %d variaveis)\n", MAX_VARS_EXAUSTIVO);
+        printf("  --contar | --enumerar      forca bruta contando ou listando todos os modelos\n");
+        printf("  --conferir                 compara a resposta do CDCL com a forca bruta\n");
+        printf("  --threads=N                threads da forca bruta (padrao: 1)\n");
+        printf("  --portfolio=N              N solvers diversificados em paralelo, trocando clausulas\n");
+        printf("  --cubos=N                  cubo-e-conquista com N threads roubando trabalho\n");
+        printf("  --profundidade=D           profundidade do lookahead que gera os cubos\n");
+        printf("  --semente=S                semente da busca (0 = deterministica)\n");
+        return 1;
+    }
+    bool via_pipe;
+    FILE *fp = abrir_cnf(caminho, &via_pipe);
+    if (fp == NULL){
+        printf("Erro ao abrir o arquivo.\n");
+        return 1;
+    }
+    clock_t inicio = clock();
+    formula F;
+    bool lido = read_formula(fp, &F);
+    if (via_pipe){
+        pclose(fp);
+    }
+    else if (fp != stdin){
+        fclose(fp);
+    }
+    if (!lido){
+        liberar_formula(&F);
+        return 1;
+    }
+    printf("c %d variaveis, %d clausulas, %d literais lidos em %.2fs\n", F.num_variaveis, F.num_clausulas,
+           F.num_literais, (double)(clock() - inicio) / CLOCKS_PER_SEC);
+
+    bool *interpretacao = (bool*)malloc(F.num_variaveis * sizeof(bool));
+
+    if (op.modo != MODO_CDCL && F.num_variaveis > MAX_VARS_EXAUSTIVO){
+        printf("Erro: forca bruta so ate %d variaveis.\n", MAX_VARS_EXAUSTIVO);
+        free(interpretacao);
+        liberar_formula(&F);
+        return 1;
+    }
+    int saida = 0; // 1 se o modelo não conferir com a fórmula original
+    formula simplificada;
+    formula *B = &F; // Fórmula entregue à busca CDCL
+    vetor pilha = {NULL, 0, 0};
+    if (op.simplificar && (op.modo == MODO_CDCL || op.modo == MODO_CONFERIR)){
+        preprocessar(&F, &simplificada, &pilha);
+        B = &simplificada;
+    }
+    if (op.modo == MODO_CONTAR || op.modo == MODO_ENUMERAR){
+        uint64_t modelos = exaustivo(&F, op.modo, op.threads, interpretacao);
+        printf("c %llu modelos\n", (unsigned long long)modelos);
+    }
+    else if (op.modo == MODO_EXAUSTIVO){
+        if (exaustivo(&F, op.modo, op.threads, interpretacao) > 0){
+            solucao(interpretacao, F.num_variaveis);
+        }
+        else {
+            printf("UNSAT!\n");
+        }
+    }
+    else if (op.modo == MODO_CONFERIR){
+        bool cdcl = SAT_SOLVER(B, interpretacao, &op);
+        if (cdcl && !modelo_original(&F, &pilha, interpretacao)){
+            modelo_invalido();
+            saida = 1;
+        }
+        bool forca = exaustivo(&F, MODO_EXAUSTIVO, op.threads, interpretacao) > 0;
+        printf("c CDCL: %s, forca bruta: %s\n", cdcl ? "SAT" : "UNSAT", forca ? "SAT" : "UNSAT");
+        printf(cdcl == forca ? "OK\n" : "DIVERGENCIA!\n");
+        if (cdcl != forca){
+            saida = 1;
+        }
+    }
+    else {
+        bool sat;
+        if (op.cubos > 0){
+            int profundidade = op.profundidade;
+            if (profundidade == 0){ // Padrão: uns 8 cubos por thread
+                profundidade = 1;
+                while ((1 << profundidade) < 8 * op.cubos){
+                    profundidade++;
+                }
+            }
+            sat = cubo_e_conquista(B, interpretacao, &op, profundidade);
+        }
+        else if (op.portfolio > 1){
+            sat = portfolio(B, interpretacao, &op);
+        }
+        else {
+            sat = SAT_SOLVER(B, interpretacao, &op);
+        }
+        if (!sat){
+            printf("UNSAT!\n");
+        }
+        else if (!modelo_original(&F, &pilha, interpretacao)){
+            modelo_invalido();
+            saida = 1;
+        }
+        else {
+            solucao(interpretacao, F.num_variaveis);
+        }
+    }
+    if (B != &F){
+        liberar_formula(B);
     }
+    free(pilha.dados);
     free(interpretacao);
-    return 0;
+    liberar_formula(&F);
+    return saida;
 }
+#endif
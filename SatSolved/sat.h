@@ -0,0 +1,62 @@
+// Interface incremental do solver CDCL de sat.c.
+// O mesmo solver atende várias consultas seguidas, mantendo as cláusulas aprendidas,
+// as atividades e as fases de uma chamada para a outra. Os literais seguem o formato
+// DIMACS: a variável x (1, 2, ...) aparece como x ou -x. O 0 nunca é literal: numa lista
+// (sat_adicionar, sat_resolver) ele termina a lista antes de tam, então um vetor no formato
+// DIMACS {1, -2, 0} pode ser passado com tam 3; sat_valor(S, 0) dá -1 e sat_falhou(S, 0), false.
+// Para usar como biblioteca, compile sat.c sem o main:
+//     gcc -O2 -pthread -DSAT_BIBLIOTECA -c sat.c
+
+#ifndef SAT_H
+#define SAT_H
+
+#include <stdbool.h>
+
+#define RES_DESCONHECIDO 0   // Busca interrompida (limite de conflitos ou outra thread terminou antes)
+#define RES_SAT 10           // Mesmos códigos de saída usados pelos solvers de competição
+#define RES_UNSAT 20
+
+typedef struct solver solver;
+
+//------ Cria um solver vazio, sem variáveis nem cláusulas --------
+solver *sat_novo(void);
+
+//------ Libera o solver e tudo o que ele aprendeu --------
+void sat_liberar(solver *S);
+
+//------ Cria uma variável nova e devolve o seu número (1, 2, ...) --------
+// Não é obrigatório: sat_adicionar cria sozinho as variáveis que aparecerem.
+int sat_nova_variavel(solver *S);
+
+//------ Adiciona uma cláusula (disjunção dos literais); false se a fórmula ficou insatisfatível --------
+// Se houver um escopo aberto por sat_empurrar, a cláusula vale só até o sat_retirar
+// correspondente. O false não depende de suposições.
+bool sat_adicionar(solver *S, const int *lits, int tam);
+
+//------ Resolve supondo verdadeiros os literais dados (podem ser NULL/0) --------
+// As suposições valem só para esta chamada. limite_conflitos: conflitos permitidos nesta
+// chamada (-1 = sem limite). Retorna RES_SAT, RES_UNSAT ou RES_DESCONHECIDO (limite esgotado).
+int sat_resolver(solver *S, const int *suposicoes, int tam, long limite_conflitos);
+
+//------ Valor do literal no último modelo: 1, 0 ou -1 (variável criada depois do modelo) --------
+int sat_valor(solver *S, int lit);
+
+//------ Diz se a suposição lit fez parte do motivo do último RES_UNSAT --------
+// As suposições marcadas formam um subconjunto já insatisfatível junto com a
+// fórmula. Se nenhuma for marcada, a fórmula é insatisfatível sozinha.
+bool sat_falhou(solver *S, int lit);
+
+//------ Totais acumulados desde sat_novo: decisões, propagações e conflitos --------
+void sat_estatisticas(solver *S, long *decisoes, long *propagacoes, long *conflitos);
+
+//------ Abre um escopo de cláusulas; as adicionadas a partir daqui saem no sat_retirar --------
+// Cada escopo é um literal de ativação a: as cláusulas recebem -a e toda chamada de
+// sat_resolver supõe a. Retirar o escopo fixa -a, o que desliga aquelas cláusulas
+// para sempre. Como a ocupa o próximo número livre, quem usa escopos deve pedir as
+// variáveis novas com sat_nova_variavel em vez de inventar números.
+void sat_empurrar(solver *S);
+
+//------ Fecha o escopo mais recente (não faz nada se não houver nenhum aberto) --------
+void sat_retirar(solver *S);
+
+#endif
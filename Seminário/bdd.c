@@ -1,286 +1,2946 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Constantes para limites do sistema
-#define MAX_VARS 100     // Número máximo de variáveis booleanas
-#define MAX_NOS 10000    // Número máximo de nós no BDD
+#define VARS_INICIAIS 16        // Capacidade inicial dos vetores por variável (crescem sob demanda)
+#define TAM_SUBTABELA_INICIAL 64 // Baldes iniciais da subtabela única de cada variável (potência de 2)
+#define TAM_CACHE (1 << 18)     // Entradas da tabela de resultados do ITE (potência de 2)
+#define NOS_INICIAIS 1024       // Capacidade inicial da arena de nós
+#define LIMITE_GC_INICIAL (1 << 16) // Nós vivos que disparam a primeira coleta de lixo
+#define LIMITE_REORDENAR_INICIAL 4096 // Nós vivos que disparam o primeiro reordenamento automático
+#define MAX_CRESCIMENTO 1.2     // Quanto o BDD pode crescer enquanto uma variável é peneirada
+#define PROFUNDIDADE_TAREFAS 12 // Até essa profundidade do ITE paralelo, um dos ramos vira tarefa
+#define LOTE_NOS 256            // Índices da arena que cada thread reserva de uma vez
 
-// Estrutura de um nó do BDD (Binary Decision Diagram)
+// Aresta para um nó: (índice do nó na arena << 1) | bit de complemento
+// O bit de complemento quer dizer "negue a função apontada"
+typedef uint32_t BDD;
+
+#define BDD_COMPLEMENTO(e) ((e) ^ 1u)
+#define BDD_REGULAR(e) ((e) & ~1u)
+#define BDD_EH_COMPLEMENTO(e) ((int)((e) & 1u))
+#define BDD_INDICE(e) ((e) >> 1)
+
+#define VAR_TERMINAL -1  // var_idx do nó constante
+#define VAR_LIVRE -2     // var_idx de um nó recolhido pelo coletor (na lista livre)
+
+// Estrutura de um nó do BDD (Binary Decision Diagram): 16 bytes na arena
+// Regra canônica das arestas complementadas: o ramo SIM guardado nunca é complementado
 typedef struct NoBDD {
-    int var_idx;        // Índice da variável booleana (0, 1, 2, ...)
-    struct NoBDD *sim;  // Ponteiro para o nó quando variável = 1 (ramo THEN)
-    struct NoBDD *nao;  // Ponteiro para o nó quando variável = 0 (ramo ELSE)
-    int id;             // ID único para identificar o nó
+    int32_t var_idx;    // Índice da variável booleana (0, 1, 2, ...)
+    BDD sim;            // Aresta para o nó quando variável = 1 (ramo THEN, sempre regular)
+    BDD nao;            // Aresta para o nó quando variável = 0 (ramo ELSE, pode ser complementado)
+    uint32_t prox;      // Próximo nó no mesmo balde da tabela única (ou na lista livre); 0 = fim
 } NoBDD;
 
+// Subtabela única de uma variável: baldes encadeados indexados por (sim, nao)
+// Separar por variável permite percorrer um nível inteiro ao trocar dois níveis
+typedef struct {
+    uint32_t *baldes;   // Índice do primeiro nó de cada balde (0 = vazio)
+    uint32_t tam;       // Número de baldes (potência de 2)
+    uint32_t num;       // Nós guardados
+} SubtabelaBDD;
+
+
+// Operações guardadas na tabela de resultados
+#define OP_ITE 0        // ite(f, g, h)
+#define OP_EXISTE 1     // existe(f, cubo g)
+#define OP_E_EXISTE 2   // e_existe(f, g, cubo h)
+#define OP_RENOMEAR 3   // renomear(f); os bits acima de 2 guardam o número do mapa
+
+// Entrada da tabela de resultados (computed table): op(f, g, h) = resultado
+// A tabela tem tamanho fixo e cada entrada nova sobrescreve a antiga (cache com perdas)
+// f nunca é constante numa entrada usada, então f = 0 marca entrada vazia
+// versao só é usada pelo ITE paralelo (ímpar = entrada sendo escrita)
+typedef struct {
+    uint32_t versao;
+    uint32_t op;
+    BDD f, g, h;
+    BDD resultado;
+} EntradaCache;
+
+struct PoolBDD;
 
 // Estrutura principal do gerenciador BDD
 typedef struct {
-    NoBDD *nos[MAX_NOS];        // Array de todos os nós criados
-    int cont_nos;               // Contador de nós criados
-    char nomes_vars[MAX_VARS][20]; // Nomes das variáveis booleanas
+    NoBDD *nos;                 // Arena: todos os nós, o nó 0 é a constante 1
+    uint32_t *refs;             // Referências externas de cada nó (raízes do coletor)
+    uint32_t cap_nos;           // Capacidade da arena
+    uint32_t usados;            // Índices já entregues alguma vez (o resto nunca foi usado)
+    uint32_t livres;            // Início da lista de nós recolhidos (0 = vazia)
+    uint32_t vivos;             // Nós em uso (inclui o terminal)
+    SubtabelaBDD *subtabelas;   // Tabela única, uma subtabela por variável
+    char (*nomes_vars)[20];     // Nomes das variáveis booleanas
+    BDD *vars;                  // BDD de cada variável (mantido referenciado)
+    int *nivel_da_var;          // Posição de cada variável na ordem (0 = topo)
+    int *var_do_nivel;          // Variável que ocupa cada nível
     int cont_vars;              // Contador de variáveis criadas
-    NoBDD *zero;                // Nó constante FALSO (0)
-    NoBDD *um;                  // Nó constante VERDADEIRO (1)
+    int cap_vars;               // Capacidade dos vetores por variável
+    BDD zero;                   // Constante FALSO: aresta complementada para o nó 0
+    BDD um;                     // Constante VERDADEIRO: o nó 0, o único terminal
+    EntradaCache *cache;        // Resultados já calculados pelo ITE
+    long acertos_cache;         // Estatísticas da cache
+    long consultas_cache;
+    uint32_t limite_gc;         // Nós vivos que disparam a próxima coleta
+    long criados;               // Estatísticas do coletor
+    long coletas;
+    long recolhidos;
+    uint32_t pico_vivos;
+    uint32_t *usos;             // Arestas + referências de cada nó, só durante o reordenamento
+    int reordenar_auto;         // Reordena sozinho quando o BDD passa de limite_reordenar
+    uint32_t limite_reordenar;
+    long reordenamentos;        // Estatísticas do reordenamento
+    long trocas;
+    struct PoolBDD *pool;       // Threads do ITE paralelo (NULL = tudo sequencial)
+    int *mapa;                  // Mapa da última renomeação (variável -> variável)
+    int tam_mapa;
+    uint32_t num_mapa;          // Muda a cada mapa novo, para a cache não misturar mapas
 } GerenciadorBDD;
 
 
 // ==================== FUNÇÕES BÁSICAS DO BDD ====================
 
+void bdd_usar_threads(GerenciadorBDD *ger, int num);
+
 /**
  * Inicializa o gerenciador BDD
  * Retorna: Ponteiro para o gerenciador alocado
  */
-GerenciadorBDD* bdd_iniciar() 
+GerenciadorBDD* bdd_iniciar()
 {
     // Aloca memória para o gerenciador
     GerenciadorBDD *ger = (GerenciadorBDD*)malloc(sizeof(GerenciadorBDD));
-    ger->cont_nos = 0;
     ger->cont_vars = 0;
-    
-    // Cria os nós constantes (terminal nodes)
-    ger->zero = (NoBDD*)malloc(sizeof(NoBDD));
-    ger->um = (NoBDD*)malloc(sizeof(NoBDD));
-    
-    // Configura nó FALSO (0)
-    ger->zero->var_idx = -1;    // -1 indica nó constante
-    ger->zero->sim = ger->zero->nao = NULL;
-    ger->zero->id = 0;
-    
-    // Configura nó VERDADEIRO (1)
-    ger->um->var_idx = -1;
-    ger->um->sim = ger->um->nao = NULL;
-    ger->um->id = 1;
-    
-    // Adiciona os nós constantes ao array de nós
-    ger->nos[ger->cont_nos++] = ger->zero;
-    ger->nos[ger->cont_nos++] = ger->um;
-    
+    ger->cap_vars = VARS_INICIAIS;
+    ger->subtabelas = (SubtabelaBDD*)malloc(ger->cap_vars * sizeof(SubtabelaBDD));
+    ger->nomes_vars = (char (*)[20])malloc(ger->cap_vars * sizeof(*ger->nomes_vars));
+    ger->vars = (BDD*)malloc(ger->cap_vars * sizeof(BDD));
+    ger->nivel_da_var = (int*)malloc(ger->cap_vars * sizeof(int));
+    ger->var_do_nivel = (int*)malloc(ger->cap_vars * sizeof(int));
+    ger->cap_nos = NOS_INICIAIS;
+    ger->nos = (NoBDD*)malloc(ger->cap_nos * sizeof(NoBDD));
+    ger->refs = (uint32_t*)calloc(ger->cap_nos, sizeof(uint32_t));
+    ger->usos = NULL;
+    ger->pool = NULL;
+    ger->mapa = NULL;
+    ger->tam_mapa = 0;
+    ger->num_mapa = 0;
+    ger->cache = (EntradaCache*)calloc(TAM_CACHE, sizeof(EntradaCache));
+    ger->acertos_cache = 0;
+    ger->consultas_cache = 0;
+    ger->limite_gc = LIMITE_GC_INICIAL;
+    ger->criados = 0;
+    ger->coletas = 0;
+    ger->recolhidos = 0;
+    ger->reordenar_auto = 0;
+    ger->limite_reordenar = LIMITE_REORDENAR_INICIAL;
+    ger->reordenamentos = 0;
+    ger->trocas = 0;
+
+    // Cria o nó constante (terminal node) no índice 0; FALSO é o complemento dele
+    ger->nos[0].var_idx = VAR_TERMINAL;
+    ger->nos[0].sim = ger->nos[0].nao = 0;
+    ger->nos[0].prox = 0;
+    ger->usados = 1;
+    ger->livres = 0;
+    ger->vivos = 1;
+    ger->pico_vivos = 1;
+    ger->um = 0;
+    ger->zero = BDD_COMPLEMENTO(ger->um);
+
     return ger;
 }
 
 /**
- * Cria uma nova variável booleana no BDD
- * ger: Gerenciador BDD
- * nome: Nome da variável (ex: "A", "B", "C")
- * Retorna: Índice da variável criada
+ * Libera o gerenciador e todos os nós criados por ele
  */
-int bdd_nova_var(GerenciadorBDD *ger, const char *nome) 
+void bdd_liberar(GerenciadorBDD *ger)
 {
-    if (ger->cont_vars >= MAX_VARS) return -1;
-    strcpy(ger->nomes_vars[ger->cont_vars], nome);
-    return ger->cont_vars++;
+    if (ger->pool != NULL) bdd_usar_threads(ger, 1);
+    free(ger->nos);
+    free(ger->refs);
+    for (int v = 0; v < ger->cont_vars; v++) free(ger->subtabelas[v].baldes);
+    free(ger->subtabelas);
+    free(ger->nomes_vars);
+    free(ger->vars);
+    free(ger->nivel_da_var);
+    free(ger->var_do_nivel);
+    free(ger->cache);
+    free(ger->mapa);
+    free(ger);
+}
+
+/**
+ * Protege f do coletor de lixo enquanto o chamador o usar
+ * Todo BDD guardado entre duas operações precisa de uma referência
+ * Retorna: o próprio f (para usar como bdd_ref(ger, bdd_e(...)))
+ */
+BDD bdd_ref(GerenciadorBDD *ger, BDD f)
+{
+    ger->refs[BDD_INDICE(f)]++;
+    return f;
+}
+
+/**
+ * Solta uma referência criada por bdd_ref
+ */
+void bdd_deref(GerenciadorBDD *ger, BDD f)
+{
+    if (ger->refs[BDD_INDICE(f)] > 0) ger->refs[BDD_INDICE(f)]--;
+}
+
+/**
+ * Posição de (sim, nao) na subtabela da variável
+ */
+static uint32_t bdd_hash(BDD no_sim, BDD no_nao, uint32_t tam_tabela)
+{
+    uint64_t h = (uint64_t)no_sim * 0xC2B2AE3D27D4EB4FULL;
+    h ^= (uint64_t)no_nao * 0x165667B19E3779F9ULL;
+    h ^= h >> 29;
+    return (uint32_t)h & (tam_tabela - 1);
+}
+
+/**
+ * Dobra o número de baldes de uma subtabela e redistribui os nós
+ * Chamada quando ela passa de 3/4 de ocupação, o que mantém as listas curtas
+ */
+static void bdd_redimensionar(GerenciadorBDD *ger, SubtabelaBDD *st)
+{
+    uint32_t novo_tam = 2 * st->tam;
+    uint32_t *nova = (uint32_t*)calloc(novo_tam, sizeof(uint32_t));
+    for (uint32_t b = 0; b < st->tam; b++) {
+        uint32_t i = st->baldes[b];
+        while (i != 0) {
+            NoBDD *no = &ger->nos[i];
+            uint32_t prox = no->prox;
+            uint32_t h = bdd_hash(no->sim, no->nao, novo_tam);
+            no->prox = nova[h];
+            nova[h] = i;
+            i = prox;
+        }
+    }
+    free(st->baldes);
+    st->baldes = nova;
+    st->tam = novo_tam;
+}
+
+/**
+ * Dobra a capacidade da arena (os índices continuam válidos no realloc)
+ */
+static void bdd_crescer_arena(GerenciadorBDD *ger)
+{
+    uint32_t cap = 2 * ger->cap_nos;
+    ger->nos = (NoBDD*)realloc(ger->nos, cap * sizeof(NoBDD));
+    ger->refs = (uint32_t*)realloc(ger->refs, cap * sizeof(uint32_t));
+    memset(ger->refs + ger->cap_nos, 0, (cap - ger->cap_nos) * sizeof(uint32_t));
+    if (ger->usos != NULL) {
+        ger->usos = (uint32_t*)realloc(ger->usos, cap * sizeof(uint32_t));
+    }
+    ger->cap_nos = cap;
 }
 
+/**
+ * Entrega um índice livre da arena: reaproveita um nó recolhido ou usa um novo,
+ * dobrando a arena quando ela acaba
+ */
+static uint32_t bdd_novo_indice(GerenciadorBDD *ger)
+{
+    if (ger->livres != 0) {
+        uint32_t i = ger->livres;
+        ger->livres = ger->nos[i].prox;
+        return i;
+    }
+    if (ger->usados == ger->cap_nos) bdd_crescer_arena(ger);
+    return ger->usados++;
+}
 
 /**
  * Encontra um nó existente ou cria um novo nó
  * Este é o coração do BDD - garante canonicidade
+ * Custo esperado O(1): só percorre o balde de (var_idx, no_sim, no_nao)
  */
-NoBDD* bdd_encontrar_ou_criar_no(GerenciadorBDD *ger, int var_idx, 
-                                NoBDD *no_sim, NoBDD *no_nao) {
+BDD bdd_encontrar_ou_criar_no(GerenciadorBDD *ger, int var_idx,
+                              BDD no_sim, BDD no_nao) {
     // Regra de redução: se ramos são iguais, retorna um deles
     if (no_sim == no_nao) return no_sim;
-    
+
+    // Regra das arestas complementadas: ramo SIM regular. Se vier complementado,
+    // guarda-se a negação do nó (os dois ramos negados) e devolve-se a aresta negada
+    if (BDD_EH_COMPLEMENTO(no_sim)) {
+        return BDD_COMPLEMENTO(bdd_encontrar_ou_criar_no(ger, var_idx, BDD_COMPLEMENTO(no_sim),
+                                                         BDD_COMPLEMENTO(no_nao)));
+    }
+
     // Procura por nó existente com mesma estrutura (canonicidade)
-    for (int i = 0; i < ger->cont_nos; i++) 
+    SubtabelaBDD *st = &ger->subtabelas[var_idx];
+    uint32_t h = bdd_hash(no_sim, no_nao, st->tam);
+    for (uint32_t i = st->baldes[h]; i != 0; i = ger->nos[i].prox)
     {
-        NoBDD *no = ger->nos[i];
-        if (no->var_idx == var_idx && 
-            no->sim == no_sim && 
+        NoBDD *no = &ger->nos[i];
+        if (no->sim == no_sim &&
             no->nao == no_nao) {
-            return no;  // Retorna nó existente
+            return i << 1;  // Retorna nó existente
         }
     }
-    
-    // Verifica limite de nós
-    if (ger->cont_nos >= MAX_NOS) return NULL;
-    
+
+    // Subtabela cheia demais: cresce antes de inserir
+    if (st->num + 1 > st->tam / 4 * 3) {
+        bdd_redimensionar(ger, st);
+        h = bdd_hash(no_sim, no_nao, st->tam);
+    }
+
     // Cria novo nó
-    NoBDD *novo_no = (NoBDD*)malloc(sizeof(NoBDD));
+    uint32_t i = bdd_novo_indice(ger);
+    NoBDD *novo_no = &ger->nos[i];
     novo_no->var_idx = var_idx;
     novo_no->sim = no_sim;
     novo_no->nao = no_nao;
-    novo_no->id = ger->cont_nos;
-    
-    // Adiciona ao array de nós
-    ger->nos[ger->cont_nos++] = novo_no;
-    return novo_no;
+    ger->vivos++;
+    ger->criados++;
+    if (ger->vivos > ger->pico_vivos) ger->pico_vivos = ger->vivos;
+
+    // Durante o reordenamento cada aresta conta como um uso do filho
+    if (ger->usos != NULL) {
+        ger->usos[i] = 0;
+        ger->usos[BDD_INDICE(no_sim)]++;
+        ger->usos[BDD_INDICE(no_nao)]++;
+    }
+
+    // Insere no início do balde
+    novo_no->prox = st->baldes[h];
+    st->baldes[h] = i;
+    st->num++;
+    return i << 1;
+}
+
+/**
+ * Cria uma nova variável booleana no BDD, no fim da ordem atual
+ * ger: Gerenciador BDD
+ * nome: Nome da variável (ex: "A", "B", "C")
+ * Retorna: Índice da variável criada
+ */
+int bdd_nova_var(GerenciadorBDD *ger, const char *nome)
+{
+    if (ger->cont_vars == ger->cap_vars) {
+        ger->cap_vars *= 2;
+        ger->subtabelas = (SubtabelaBDD*)realloc(ger->subtabelas, ger->cap_vars * sizeof(SubtabelaBDD));
+        ger->nomes_vars = (char (*)[20])realloc(ger->nomes_vars, ger->cap_vars * sizeof(*ger->nomes_vars));
+        ger->vars = (BDD*)realloc(ger->vars, ger->cap_vars * sizeof(BDD));
+        ger->nivel_da_var = (int*)realloc(ger->nivel_da_var, ger->cap_vars * sizeof(int));
+        ger->var_do_nivel = (int*)realloc(ger->var_do_nivel, ger->cap_vars * sizeof(int));
+    }
+    int v = ger->cont_vars;
+    snprintf(ger->nomes_vars[v], sizeof(ger->nomes_vars[v]), "%s", nome);
+    ger->subtabelas[v].tam = TAM_SUBTABELA_INICIAL;
+    ger->subtabelas[v].num = 0;
+    ger->subtabelas[v].baldes = (uint32_t*)calloc(TAM_SUBTABELA_INICIAL, sizeof(uint32_t));
+    ger->nivel_da_var[v] = v;
+    ger->var_do_nivel[v] = v;
+    ger->vars[ger->cont_vars] = bdd_ref(ger, bdd_encontrar_ou_criar_no(ger, ger->cont_vars, ger->um, ger->zero));
+    return ger->cont_vars++;
+}
+
+/**
+ * Procura uma variável pelo nome (comparado como guardado, com até 19 caracteres)
+ * Retorna: índice da variável, ou -1 se não existir
+ */
+int bdd_procurar_var(GerenciadorBDD *ger, const char *nome)
+{
+    char guardado[sizeof(ger->nomes_vars[0])];
+    snprintf(guardado, sizeof(guardado), "%s", nome);
+    for (int v = 0; v < ger->cont_vars; v++) {
+        if (strcmp(ger->nomes_vars[v], guardado) == 0) return v;
+    }
+    return -1;
 }
 
 /**
- * Cria um nó que representa uma variável booleana
+ * BDD que representa uma variável booleana
  * Para uma variável A: se A=1 retorna 1, se A=0 retorna 0
  */
-NoBDD* bdd_variavel(GerenciadorBDD *ger, int var_idx) 
+BDD bdd_variavel(GerenciadorBDD *ger, int var_idx)
+{
+    return ger->vars[var_idx];
+}
+
+
+/**
+ * Nível do topo de uma aresta (posição da sua variável na ordem atual)
+ * Constantes ficam abaixo de todas as variáveis
+ */
+static int bdd_topo(GerenciadorBDD *ger, BDD f)
+{
+    int var_idx = ger->nos[BDD_INDICE(f)].var_idx;
+    return var_idx < 0 ? INT_MAX : ger->nivel_da_var[var_idx];
+}
+
+/**
+ * Cofator de f em relação à variável var_idx (valor = 1 escolhe o ramo SIM)
+ * O complemento da aresta passa para o ramo escolhido
+ */
+static BDD bdd_cofator(GerenciadorBDD *ger, BDD f, int var_idx, int valor)
+{
+    NoBDD *no = &ger->nos[BDD_INDICE(f)];
+    if (no->var_idx != var_idx) return f;  // f não depende de var_idx neste nível
+    BDD ramo = valor ? no->sim : no->nao;
+    return BDD_EH_COMPLEMENTO(f) ? BDD_COMPLEMENTO(ramo) : ramo;
+}
+
+
+// ==================== COLETA DE LIXO ====================
+
+/**
+ * Marca tudo o que é alcançável a partir de raiz (pilha explícita: BDDs fundos
+ * estourariam a pilha de chamadas)
+ */
+static void bdd_marcar(GerenciadorBDD *ger, uint8_t *marca, uint32_t **pilha, uint32_t *cap, BDD raiz)
+{
+    uint32_t topo = 0;
+    (*pilha)[topo++] = BDD_INDICE(raiz);
+    while (topo > 0) {
+        uint32_t i = (*pilha)[--topo];
+        if (marca[i]) continue;
+        marca[i] = 1;
+        if (i == 0) continue;
+        if (topo + 2 > *cap) {
+            *cap *= 2;
+            *pilha = (uint32_t*)realloc(*pilha, *cap * sizeof(uint32_t));
+        }
+        (*pilha)[topo++] = BDD_INDICE(ger->nos[i].sim);
+        (*pilha)[topo++] = BDD_INDICE(ger->nos[i].nao);
+    }
+}
+
+/**
+ * Coleta de lixo por marcação e varredura
+ * Raízes: nós com referência externa e os BDDs em extras (argumentos da operação
+ * que está começando). Os nós não alcançados voltam para a lista livre e as
+ * entradas da cache que apontavam para eles são apagadas.
+ */
+void bdd_coletar_lixo(GerenciadorBDD *ger, const BDD *extras, int num_extras)
+{
+    uint8_t *marca = (uint8_t*)calloc(ger->usados, sizeof(uint8_t));
+    uint32_t cap = 1024;
+    uint32_t *pilha = (uint32_t*)malloc(cap * sizeof(uint32_t));
+    for (uint32_t i = 0; i < ger->usados; i++) {
+        if (ger->refs[i] > 0 && !marca[i]) bdd_marcar(ger, marca, &pilha, &cap, i << 1);
+    }
+    for (int k = 0; k < num_extras; k++) {
+        bdd_marcar(ger, marca, &pilha, &cap, extras[k]);
+    }
+    free(pilha);
+
+    // Varredura: tira os nós mortos dos baldes e os empilha na lista livre
+    uint32_t recolhidos = 0;
+    for (int v = 0; v < ger->cont_vars; v++) {
+        SubtabelaBDD *st = &ger->subtabelas[v];
+        for (uint32_t b = 0; b < st->tam; b++) {
+            uint32_t *elo = &st->baldes[b];
+            while (*elo != 0) {
+                uint32_t i = *elo;
+                if (marca[i]) {
+                    elo = &ger->nos[i].prox;
+                    continue;
+                }
+                *elo = ger->nos[i].prox;
+                ger->nos[i].var_idx = VAR_LIVRE;
+                ger->nos[i].prox = ger->livres;
+                ger->livres = i;
+                st->num--;
+                recolhidos++;
+            }
+        }
+    }
+
+    // Entradas da cache com algum nó morto ficariam apontando para lixo
+    for (int k = 0; k < TAM_CACHE; k++) {
+        EntradaCache *e = &ger->cache[k];
+        if (e->f != 0 && (!marca[BDD_INDICE(e->f)] || !marca[BDD_INDICE(e->g)] ||
+                          !marca[BDD_INDICE(e->h)] || !marca[BDD_INDICE(e->resultado)])) {
+            e->f = e->g = e->h = e->resultado = 0;
+        }
+    }
+    free(marca);
+
+    ger->vivos -= recolhidos;
+    ger->recolhidos += recolhidos;
+    ger->coletas++;
+}
+
+/**
+ * Ponto seguro para coletar: o começo de uma operação, quando só as referências
+ * externas e os argumentos da operação estão em uso
+ * O limite seguinte é o dobro do que sobreviveu, então a memória fica proporcional
+ * ao que está realmente vivo
+ */
+static void bdd_talvez_coletar(GerenciadorBDD *ger, const BDD *args, int num_args)
+{
+    if (ger->vivos < ger->limite_gc) return;
+    bdd_coletar_lixo(ger, args, num_args);
+    ger->limite_gc = 2 * ger->vivos > LIMITE_GC_INICIAL ? 2 * ger->vivos : LIMITE_GC_INICIAL;
+}
+
+
+// ==================== REORDENAMENTO DINÂMICO ====================
+
+/**
+ * Solta um uso do nó de e durante o reordenamento; sem usos, o nó sai da sua
+ * subtabela na hora (e solta os filhos), para que o tamanho do BDD medido a cada
+ * troca seja exato
+ */
+static void bdd_soltar_uso(GerenciadorBDD *ger, BDD e)
+{
+    uint32_t i = BDD_INDICE(e);
+    if (i == 0 || --ger->usos[i] > 0) return;
+
+    NoBDD *no = &ger->nos[i];
+    SubtabelaBDD *st = &ger->subtabelas[no->var_idx];
+    uint32_t *elo = &st->baldes[bdd_hash(no->sim, no->nao, st->tam)];
+    while (*elo != i) elo = &ger->nos[*elo].prox;
+    *elo = no->prox;
+    st->num--;
+
+    BDD sim = no->sim, nao = no->nao;
+    no->var_idx = VAR_LIVRE;
+    no->prox = ger->livres;
+    ger->livres = i;
+    ger->vivos--;
+    bdd_soltar_uso(ger, sim);
+    bdd_soltar_uso(ger, nao);
+}
+
+/**
+ * Troca as variáveis dos níveis nivel e nivel + 1
+ * Seja x a de cima e y a de baixo. Nós de x cujos filhos não dependem de y só
+ * descem de nível, sem mudar. Os outros são reescritos no mesmo índice como nós
+ * de y, com filhos novos em x:
+ *     F = x ? (y ? f11 : f10) : (y ? f01 : f00)  vira  y ? (x ? f11 : f01) : (x ? f10 : f00)
+ * Como o índice não muda, toda aresta que apontava para F (inclusive as externas)
+ * continua valendo. O ramo SIM de F era regular, então f11 e o novo ramo SIM também são.
+ */
+static void bdd_trocar_niveis(GerenciadorBDD *ger, int nivel)
+{
+    int x = ger->var_do_nivel[nivel];
+    int y = ger->var_do_nivel[nivel + 1];
+    ger->trocas++;
+
+    // Separa numa lista (ligada por prox) os nós de x que dependem de y
+    SubtabelaBDD *sx = &ger->subtabelas[x];
+    uint32_t mover = 0;
+    for (uint32_t b = 0; b < sx->tam; b++) {
+        uint32_t *elo = &sx->baldes[b];
+        while (*elo != 0) {
+            uint32_t i = *elo;
+            NoBDD *no = &ger->nos[i];
+            if (ger->nos[BDD_INDICE(no->sim)].var_idx != y && ger->nos[BDD_INDICE(no->nao)].var_idx != y) {
+                elo = &no->prox;
+                continue;
+            }
+            *elo = no->prox;
+            no->prox = mover;
+            mover = i;
+            sx->num--;
+        }
+    }
+
+    // A ordem muda antes de criar nós, para os novos de x já nascerem no nível de baixo
+    ger->var_do_nivel[nivel] = y;
+    ger->var_do_nivel[nivel + 1] = x;
+    ger->nivel_da_var[y] = nivel;
+    ger->nivel_da_var[x] = nivel + 1;
+
+    while (mover != 0) {
+        uint32_t i = mover;
+        mover = ger->nos[i].prox;
+        BDD f1 = ger->nos[i].sim, f0 = ger->nos[i].nao;
+        BDD f11 = bdd_cofator(ger, f1, y, 1), f10 = bdd_cofator(ger, f1, y, 0);
+        BDD f01 = bdd_cofator(ger, f0, y, 1), f00 = bdd_cofator(ger, f0, y, 0);
+
+        // Cria os filhos antes de soltar os antigos: eles podem compartilhar netos
+        BDD no_sim = bdd_encontrar_ou_criar_no(ger, x, f11, f01);
+        ger->usos[BDD_INDICE(no_sim)]++;
+        BDD no_nao = bdd_encontrar_ou_criar_no(ger, x, f10, f00);
+        ger->usos[BDD_INDICE(no_nao)]++;
+        bdd_soltar_uso(ger, f1);
+        bdd_soltar_uso(ger, f0);
+
+        // Reescreve o nó como nó de y (a arena pode ter crescido: relê o ponteiro)
+        NoBDD *no = &ger->nos[i];
+        no->var_idx = y;
+        no->sim = no_sim;
+        no->nao = no_nao;
+        SubtabelaBDD *sy = &ger->subtabelas[y];
+        if (sy->num + 1 > sy->tam / 4 * 3) bdd_redimensionar(ger, sy);
+        uint32_t h = bdd_hash(no_sim, no_nao, sy->tam);
+        no->prox = sy->baldes[h];
+        sy->baldes[h] = i;
+        sy->num++;
+    }
+}
+
+/**
+ * Leva a variável v do seu nível até o alvo, uma troca adjacente por vez,
+ * parando antes se o BDD passar de limite nós
+ * Retorna: o nível em que v ficou
+ */
+static int bdd_mover_var(GerenciadorBDD *ger, int v, int alvo, uint32_t limite,
+                         int *melhor_nivel, uint32_t *melhor)
+{
+    int nivel = ger->nivel_da_var[v];
+    while (nivel != alvo) {
+        if (nivel < alvo) bdd_trocar_niveis(ger, nivel++);
+        else bdd_trocar_niveis(ger, --nivel);
+        if (ger->vivos < *melhor) {
+            *melhor = ger->vivos;
+            *melhor_nivel = nivel;
+        }
+        if (ger->vivos > limite) break;
+    }
+    return nivel;
+}
+
+/**
+ * Peneiramento de Rudell: cada variável, das mais populosas para as menos, é
+ * levada primeiro à ponta mais próxima e depois à outra, e termina na posição em
+ * que o BDD ficou menor. O caminho é abandonado se o BDD crescer mais que
+ * MAX_CRESCIMENTO em relação ao melhor tamanho visto.
+ * Raízes: as referências externas e os BDDs em extras (que continuam válidos:
+ * as trocas preservam a função de cada índice vivo)
+ */
+static void bdd_peneirar(GerenciadorBDD *ger, const BDD *extras, int num_extras)
+{
+    int n = ger->cont_vars;
+    if (n < 2) return;
+
+    // Só nós alcançáveis, e cada um com a contagem exata de quem o usa
+    bdd_coletar_lixo(ger, extras, num_extras);
+    ger->usos = (uint32_t*)malloc(ger->cap_nos * sizeof(uint32_t));
+    memcpy(ger->usos, ger->refs, ger->usados * sizeof(uint32_t));
+    for (int k = 0; k < num_extras; k++) ger->usos[BDD_INDICE(extras[k])]++;
+    for (uint32_t i = 1; i < ger->usados; i++) {
+        if (ger->nos[i].var_idx < 0) continue;
+        ger->usos[BDD_INDICE(ger->nos[i].sim)]++;
+        ger->usos[BDD_INDICE(ger->nos[i].nao)]++;
+    }
+
+    // Ordem de visita: variáveis com mais nós primeiro (insertion sort, n é pequeno)
+    int *ordem = (int*)malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++) {
+        int v = k, j = k;
+        while (j > 0 && ger->subtabelas[ordem[j - 1]].num < ger->subtabelas[v].num) {
+            ordem[j] = ordem[j - 1];
+            j--;
+        }
+        ordem[j] = v;
+    }
+
+    for (int k = 0; k < n; k++) {
+        int v = ordem[k];
+        int melhor_nivel = ger->nivel_da_var[v];
+        uint32_t melhor = ger->vivos;
+        uint32_t limite = (uint32_t)(melhor * MAX_CRESCIMENTO);
+        if (melhor_nivel < n / 2) {
+            bdd_mover_var(ger, v, 0, limite, &melhor_nivel, &melhor);
+            bdd_mover_var(ger, v, n - 1, (uint32_t)(melhor * MAX_CRESCIMENTO), &melhor_nivel, &melhor);
+        }
+        else {
+            bdd_mover_var(ger, v, n - 1, limite, &melhor_nivel, &melhor);
+            bdd_mover_var(ger, v, 0, (uint32_t)(melhor * MAX_CRESCIMENTO), &melhor_nivel, &melhor);
+        }
+        bdd_mover_var(ger, v, melhor_nivel, UINT32_MAX, &melhor_nivel, &melhor);
+    }
+    free(ordem);
+    free(ger->usos);
+    ger->usos = NULL;
+
+    // Índices recolhidos podem ter sido reaproveitados por outras funções
+    memset(ger->cache, 0, TAM_CACHE * sizeof(EntradaCache));
+    ger->reordenamentos++;
+}
+
+/**
+ * Reordena as variáveis agora, por peneiramento
+ * Todo BDD que o chamador ainda for usar precisa estar referenciado
+ */
+void bdd_reordenar(GerenciadorBDD *ger)
+{
+    bdd_peneirar(ger, NULL, 0);
+}
+
+/**
+ * Liga ou desliga o reordenamento automático: quando o número de nós vivos passa
+ * do limite, a próxima operação peneira antes de começar, e o limite vira o dobro
+ * do tamanho obtido
+ */
+void bdd_reordenamento_automatico(GerenciadorBDD *ger, int ligado)
 {
-    return bdd_encontrar_ou_criar_no(ger, var_idx, ger->um, ger->zero);
+    ger->reordenar_auto = ligado;
 }
 
+/**
+ * Ponto seguro do começo de cada operação: reordena ou coleta lixo se for a hora
+ */
+static void bdd_ponto_seguro(GerenciadorBDD *ger, BDD f, BDD g, BDD h)
+{
+    BDD args[3] = {f, g, h};
+    if (ger->reordenar_auto && ger->vivos >= ger->limite_reordenar) {
+        bdd_peneirar(ger, args, 3);
+        ger->limite_reordenar = 2 * ger->vivos > LIMITE_REORDENAR_INICIAL ? 2 * ger->vivos : LIMITE_REORDENAR_INICIAL;
+        return;
+    }
+    bdd_talvez_coletar(ger, args, 3);
+}
 
 // ==================== OPERAÇÕES BOOLEANAS ====================
 
 /**
- * Operação AND (E) entre dois BDDs
- * Implementa: f AND g
+ * Ordena dois argumentos intercambiáveis (menor topo, depois menor índice, primeiro)
+ * Assim ite(f, 1, h) e ite(h, 1, f) caem na mesma entrada da cache
  */
-NoBDD* bdd_e(GerenciadorBDD *ger, NoBDD *f, NoBDD *g) 
+static int bdd_vem_antes(GerenciadorBDD *ger, BDD a, BDD b)
 {
-    // Casos base para otimização
-    if (f == ger->um && g == ger->um) return ger->um;   // 1 AND 1 = 1
-    if (f == ger->zero || g == ger->zero) return ger->zero; // 0 AND x = 0
-    if (f == g) return f;                               // f AND f = f
-    if (f == ger->um) return g;                         // 1 AND g = g
-    if (g == ger->um) return f;                         // f AND 1 = f
-    
-    // Escolhe a variável com menor índice (ordenação fixa)
-    int var_idx;
-    if (f->var_idx < g->var_idx) 
-    {
-        var_idx = f->var_idx;
-    } 
-    else 
-    {
-        var_idx = g->var_idx;
-    }
-    
-    // Calcula os cofatores (Shannon expansion)
-    NoBDD *f_sim = (f->var_idx == var_idx) ? f->sim : f;
-    NoBDD *f_nao = (f->var_idx == var_idx) ? f->nao : f;
-    NoBDD *g_sim = (g->var_idx == var_idx) ? g->sim : g;
-    NoBDD *g_nao = (g->var_idx == var_idx) ? g->nao : g;
-    
-    // Chamada recursiva para os cofatores
-    NoBDD *no_sim = bdd_e(ger, f_sim, g_sim);  // Quando var = 1
-    NoBDD *no_nao = bdd_e(ger, f_nao, g_nao);  // Quando var = 0
-    
-    // Cria/recupera o nó resultante
-    return bdd_encontrar_ou_criar_no(ger, var_idx, no_sim, no_nao);
-}
-
-/**
- * Operação OR (OU) entre dois BDDs
- * Implementa: f OR g
- */
-NoBDD* bdd_ou(GerenciadorBDD *ger, NoBDD *f, NoBDD *g) 
-{
-    // Casos base para otimização
-    if (f == ger->um || g == ger->um) return ger->um;   // 1 OR x = 1
-    if (f == ger->zero && g == ger->zero) return ger->zero; // 0 OR 0 = 0
-    if (f == g) return f;                               // f OR f = f
-    if (f == ger->zero) return g;                       // 0 OR g = g
-    if (g == ger->zero) return f;                       // f OR 0 = f
-    
-    // Escolhe a variável com menor índice
-    int var_idx;
-    if (f->var_idx < g->var_idx) 
-    {
-        var_idx = f->var_idx;
-    } 
-    else 
-    {
-        var_idx = g->var_idx;
-    }
-    
-    // Calcula os cofatores
-    NoBDD *f_sim = (f->var_idx == var_idx) ? f->sim : f;
-    NoBDD *f_nao = (f->var_idx == var_idx) ? f->nao : f;
-    NoBDD *g_sim = (g->var_idx == var_idx) ? g->sim : g;
-    NoBDD *g_nao = (g->var_idx == var_idx) ? g->nao : g;
-    
-    // Chamada recursiva
-    NoBDD *no_sim = bdd_ou(ger, f_sim, g_sim);  // Quando var = 1
-    NoBDD *no_nao = bdd_ou(ger, f_nao, g_nao);  // Quando var = 0
-    
-    return bdd_encontrar_ou_criar_no(ger, var_idx, no_sim, no_nao);
+    if (bdd_topo(ger, a) != bdd_topo(ger, b)) return bdd_topo(ger, a) < bdd_topo(ger, b);
+    return a < b;
 }
 
-// ==================== VERIFICAÇÃO DE EQUIVALÊNCIA ====================
+/**
+ * Casos terminais e triplas padrão do ITE, comuns às recursões sequencial e paralela
+ * Retorna: 1 se o resultado já é conhecido (em *resultado); senão 0, com f, g e h
+ * normalizados (f e g regulares) e *negar indicando se a resposta sai negada
+ */
+static int bdd_ite_normalizar(GerenciadorBDD *ger, BDD *pf, BDD *pg, BDD *ph, int *negar, BDD *resultado)
+{
+    BDD f = *pf, g = *pg, h = *ph;
+
+    // Casos terminais
+    if (f == ger->um) { *resultado = g; return 1; }
+    if (f == ger->zero) { *resultado = h; return 1; }
+    if (g == h) { *resultado = g; return 1; }
+    if (g == ger->um && h == ger->zero) { *resultado = f; return 1; }
+    if (g == ger->zero && h == ger->um) { *resultado = BDD_COMPLEMENTO(f); return 1; }
+
+    // Triplas padrão: argumentos iguais a f (ou a NÃO f) viram constantes...
+    if (g == f) g = ger->um;                        // ite(f, f, h) = ite(f, 1, h)
+    else if (g == BDD_COMPLEMENTO(f)) g = ger->zero; // ite(f, -f, h) = ite(f, 0, h)
+    if (h == f) h = ger->zero;                      // ite(f, g, f) = ite(f, g, 0)
+    else if (h == BDD_COMPLEMENTO(f)) h = ger->um;   // ite(f, g, -f) = ite(f, g, 1)
+    if (g == h) { *resultado = g; return 1; }
+    if (g == ger->um && h == ger->zero) { *resultado = f; return 1; }
+    if (g == ger->zero && h == ger->um) { *resultado = BDD_COMPLEMENTO(f); return 1; }
+
+    // ...as formas comutativas ficam numa ordem fixa...
+    BDD t;
+    if (g == ger->um) {                             // ite(f, 1, h) = ite(h, 1, f)
+        if (bdd_vem_antes(ger, h, f)) { t = f; f = h; h = t; }
+    }
+    else if (h == ger->zero) {                      // ite(f, g, 0) = ite(g, f, 0)
+        if (bdd_vem_antes(ger, g, f)) { t = f; f = g; g = t; }
+    }
+    else if (h == ger->um) {                        // ite(f, g, 1) = ite(-g, -f, 1)
+        if (bdd_vem_antes(ger, g, f)) { t = f; f = BDD_COMPLEMENTO(g); g = BDD_COMPLEMENTO(t); }
+    }
+    else if (g == ger->zero) {                      // ite(f, 0, h) = ite(-h, 0, -f)
+        if (bdd_vem_antes(ger, h, f)) { t = f; f = BDD_COMPLEMENTO(h); h = BDD_COMPLEMENTO(t); }
+    }
+    else if (g == BDD_COMPLEMENTO(h)) {             // ite(f, g, -g) = ite(g, f, -f)
+        if (bdd_vem_antes(ger, g, f)) { t = f; f = g; g = t; h = BDD_COMPLEMENTO(t); }
+    }
+
+    // ...f fica regular (trocando os ramos) e g também (negando o resultado)
+    if (BDD_EH_COMPLEMENTO(f)) {
+        f = BDD_COMPLEMENTO(f);
+        t = g; g = h; h = t;
+    }
+    *negar = 0;
+    if (BDD_EH_COMPLEMENTO(g)) {
+        g = BDD_COMPLEMENTO(g);
+        h = BDD_COMPLEMENTO(h);
+        *negar = 1;
+    }
+
+    *pf = f;
+    *pg = g;
+    *ph = h;
+    return 0;
+}
 
 /**
- * Verifica se dois BDDs representam a mesma função booleana
- * A canonicidade do BDD garante que funções equivalentes
- * terão exatamente a mesma estrutura
+ * Entrada da cache onde op(f, g, h) é guardado
+ */
+static EntradaCache *bdd_cache_entrada(GerenciadorBDD *ger, uint32_t op, BDD f, BDD g, BDD h)
+{
+    uint64_t chave = (uint64_t)(f ^ (op << 24)) * 0x9E3779B97F4A7C15ULL
+                   ^ (uint64_t)g * 0xC2B2AE3D27D4EB4FULL
+                   ^ (uint64_t)h * 0x165667B19E3779F9ULL;
+    return &ger->cache[(chave ^ (chave >> 31)) & (TAM_CACHE - 1)];
+}
+
+/**
+ * Recursão do ITE; não coleta lixo (os resultados parciais ainda não têm referência)
  */
-int bdd_sao_equivalentes(NoBDD *f, NoBDD *g) 
+static BDD bdd_ite_rec(GerenciadorBDD *ger, BDD f, BDD g, BDD h)
 {
-    // Se são o mesmo nó (mesmo ponteiro), são equivalentes
-    if (f == g) return 1;
-    
-    // Se um é constante e outro não, não são equivalentes
-    if ((f->var_idx == -1) != (g->var_idx == -1)) return 0;
-    
-    // Se ambos são constantes, compara seus valores
-    if (f->var_idx == -1 && g->var_idx == -1) {
-        return f->id == g->id;  // Compara 0/1
+    int negar;
+    BDD resultado;
+    if (bdd_ite_normalizar(ger, &f, &g, &h, &negar, &resultado)) return resultado;
+
+    // Consulta a cache
+    EntradaCache *e = bdd_cache_entrada(ger, OP_ITE, f, g, h);
+    ger->consultas_cache++;
+    if (e->op == OP_ITE && e->f == f && e->g == g && e->h == h) {
+        ger->acertos_cache++;
+        return negar ? BDD_COMPLEMENTO(e->resultado) : e->resultado;
     }
-    
-    // Se usam variáveis diferentes, não são equivalentes
-    if (f->var_idx != g->var_idx) return 0;
-    
-    // Verifica recursivamente os dois ramos
-    return bdd_sao_equivalentes(f->sim, g->sim) && 
-           bdd_sao_equivalentes(f->nao, g->nao);
+
+    // Expansão de Shannon pela variável mais alta (menor nível) entre f, g e h
+    int nivel = bdd_topo(ger, f);
+    if (bdd_topo(ger, g) < nivel) nivel = bdd_topo(ger, g);
+    if (bdd_topo(ger, h) < nivel) nivel = bdd_topo(ger, h);
+    int var_idx = ger->var_do_nivel[nivel];
+
+    BDD no_sim = bdd_ite_rec(ger, bdd_cofator(ger, f, var_idx, 1), bdd_cofator(ger, g, var_idx, 1),
+                             bdd_cofator(ger, h, var_idx, 1));
+    BDD no_nao = bdd_ite_rec(ger, bdd_cofator(ger, f, var_idx, 0), bdd_cofator(ger, g, var_idx, 0),
+                             bdd_cofator(ger, h, var_idx, 0));
+    resultado = bdd_encontrar_ou_criar_no(ger, var_idx, no_sim, no_nao);
+
+    // Guarda o resultado (sobrescreve o que estiver na entrada; a arena pode ter
+    // sido realocada na recursão, mas a entrada da cache não mudou de lugar)
+    e->op = OP_ITE;
+    e->f = f;
+    e->g = g;
+    e->h = h;
+    e->resultado = resultado;
+    return negar ? BDD_COMPLEMENTO(resultado) : resultado;
 }
 
-// ==================== PROGRAMA PRINCIPAL ====================
+// ==================== ITE PARALELO ====================
+//
+// Com bdd_usar_threads, cada ITE de topo é calculado por várias threads: até
+// PROFUNDIDADE_TAREFAS, o ramo SIM da expansão de Shannon vira uma tarefa na fila
+// da thread, que calcula o ramo NÃO e depois junta os dois. Threads sem trabalho
+// roubam tarefas do início das filas das outras.
+//
+// Durante a operação nada é realocado nem recolhido:
+// - cada thread pega índices da arena em lotes e publica um nó novo com CAS na
+//   cabeça do balde da subtabela (sem travas nas buscas);
+// - a cache é lida e escrita como um seqlock (versao ímpar = sendo escrita);
+// - se a arena acabar ou uma subtabela ficar cheia demais, a operação é abandonada
+//   e refeita depois de crescer tudo. O que já tinha sido calculado continua nas
+//   subtabelas e na cache, então a segunda tentativa é barata.
+//
+// As estruturas são as mesmas da versão sequencial, então os acessos concorrentes
+// usam os builtins __atomic do GCC sobre campos comuns: fora das operações
+// paralelas o código sequencial não paga nada por eles.
+
+// Um ramo da expansão que outra thread pode roubar
+typedef struct {
+    BDD f, g, h;
+    int profundidade;
+    BDD resultado;
+    atomic_int estado;  // 0 = na fila, 1 = em execução, 2 = pronta
+} TarefaITE;
+
+// Fila de tarefas de uma thread: a dona empilha e desempilha no fim, ladrões tiram do início
+typedef struct {
+    pthread_mutex_t trava;
+    TarefaITE **itens;
+    int inicio, fim, cap;
+} FilaTarefas;
+
+// Estado de cada thread (a 0 é a thread que chamou a operação)
+typedef struct {
+    struct PoolBDD *pool;
+    int id;
+    uint32_t livres;    // Índices da arena reservados para esta thread (ligados por prox)
+    long criados;       // Contadores somados ao gerenciador no fim de cada operação
+    long consultas;
+    long acertos;
+    unsigned semente;   // Escolha das vítimas de roubo
+} TrabalhadorBDD;
+
+typedef struct PoolBDD {
+    GerenciadorBDD *ger;
+    int num;                    // Threads, contando a que chama as operações
+    pthread_t *threads;
+    TrabalhadorBDD *trab;
+    FilaTarefas *filas;
+    pthread_mutex_t trava;      // Sono das threads entre operações
+    pthread_cond_t acordar;
+    pthread_mutex_t trava_arena; // Lista livre e fim da arena (lotes de LOTE_NOS)
+    atomic_int ativo;           // Há uma operação em andamento
+    atomic_int encerrar;
+    atomic_int em_operacao;     // Threads auxiliares dentro da operação atual
+    atomic_int falhou;          // Faltou espaço: a operação será refeita
+} PoolBDD;
+
+static void bdd_empilhar_tarefa(FilaTarefas *q, TarefaITE *tarefa)
+{
+    pthread_mutex_lock(&q->trava);
+    if (q->fim == q->cap) {
+        if (q->inicio > 0) {
+            memmove(q->itens, q->itens + q->inicio, (q->fim - q->inicio) * sizeof(TarefaITE*));
+            q->fim -= q->inicio;
+            q->inicio = 0;
+        }
+        else {
+            q->cap *= 2;
+            q->itens = (TarefaITE**)realloc(q->itens, q->cap * sizeof(TarefaITE*));
+        }
+    }
+    q->itens[q->fim++] = tarefa;
+    pthread_mutex_unlock(&q->trava);
+}
 
 /**
- * Função principal que testa a equivalência dos dois circuitos
- * Circuito 1: F1 = (A AND B) OR C
- * Circuito 2: F2 = (A OR C) AND (B OR C)
- * Estes circuitos são logicamente equivalentes
+ * A dona tenta tirar de volta a própria tarefa do fim da fila
+ * Retorna: 0 se ela já foi roubada
  */
-void testar_circuitos() 
+static int bdd_retomar_tarefa(FilaTarefas *q, TarefaITE *tarefa)
 {
-    printf("VERIFICACAO DE CIRCUITOS COM BDD\n");
-    printf("=================================\n\n");
-    
-    // Inicializa o sistema BDD
-    GerenciadorBDD *ger = bdd_iniciar();
-    
-    // Cria as variáveis booleanas
-    int A = bdd_nova_var(ger, "A");
-    int B = bdd_nova_var(ger, "B");
-    int C = bdd_nova_var(ger, "C");
-    
-    // Cria os nós para cada variável
-    NoBDD *varA = bdd_variavel(ger, A);
-    NoBDD *varB = bdd_variavel(ger, B);
-    NoBDD *varC = bdd_variavel(ger, C);
-    
-    printf("Circuitos para ComparaCAO:\n");
-    printf("1: F1 = (A E B) OU C\n");
-    printf("2: F2 = (A OU C) E (B OU C)\n\n");
-    
-    // Constrói o Circuito 1: F1 = (A AND B) OR C
-    NoBDD *F1_e = bdd_e(ger, varA, varB);      // (A AND B)
-    NoBDD *F1 = bdd_ou(ger, F1_e, varC);       // (A AND B) OR C
-    
-    // Constrói o Circuito 2: F2 = (A OR C) AND (B OR C)
-    NoBDD *F2_ou1 = bdd_ou(ger, varA, varC);   // (A OR C)
-    NoBDD *F2_ou2 = bdd_ou(ger, varB, varC);   // (B OR C)
-    NoBDD *F2 = bdd_e(ger, F2_ou1, F2_ou2);    // (A OR C) AND (B OR C)
-    
-    printf("Resultado da Verificacao:\n");
-    if (bdd_sao_equivalentes(F1, F2)) 
-    {
-        printf("✓ F1 e F2 sao EQUIVALENTES!\n");
-        printf("  Os dois circuitos implementam a mesma funcao logica.\n");
-    } 
-    else {
+    int ok = 0;
+    pthread_mutex_lock(&q->trava);
+    if (q->fim > q->inicio && q->itens[q->fim - 1] == tarefa) {
+        q->fim--;
+        if (q->fim == q->inicio) q->inicio = q->fim = 0;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->trava);
+    return ok;
+}
 
-        printf("✗ F1 e F2 nao sao equivalentes!\n");
+static TarefaITE *bdd_tirar_do_inicio(FilaTarefas *q)
+{
+    TarefaITE *tarefa = NULL;
+    pthread_mutex_lock(&q->trava);
+    if (q->fim > q->inicio) {
+        tarefa = q->itens[q->inicio++];
+        atomic_store_explicit(&tarefa->estado, 1, memory_order_relaxed);
+        if (q->fim == q->inicio) q->inicio = q->fim = 0;
+    }
+    pthread_mutex_unlock(&q->trava);
+    return tarefa;
+}
+
+/**
+ * Reserva mais LOTE_NOS índices para a thread: primeiro da lista livre, depois do
+ * fim da arena
+ * Retorna: 0 se a arena acabou
+ */
+static int bdd_reservar_lote(GerenciadorBDD *ger, TrabalhadorBDD *t)
+{
+    PoolBDD *P = t->pool;
+    int n = 0;
+    pthread_mutex_lock(&P->trava_arena);
+    while (n < LOTE_NOS && ger->livres != 0) {
+        uint32_t i = ger->livres;
+        ger->livres = ger->nos[i].prox;
+        ger->nos[i].prox = t->livres;
+        t->livres = i;
+        n++;
     }
-    
-    
+    while (n < LOTE_NOS && ger->usados < ger->cap_nos) {
+        uint32_t i = ger->usados++;
+        ger->nos[i].var_idx = VAR_LIVRE;
+        ger->nos[i].prox = t->livres;
+        t->livres = i;
+        n++;
+    }
+    pthread_mutex_unlock(&P->trava_arena);
+    return n > 0;
 }
 
 /**
- * Função principal do programa
+ * bdd_encontrar_ou_criar_no para várias threads ao mesmo tempo
+ * A busca não trava nada: nós publicados nunca mudam. Um nó novo entra com CAS na
+ * cabeça do balde; se outra thread mexeu no balde antes, confere os nós que ela
+ * acrescentou (pode ser o mesmo nó) e tenta de novo.
  */
-int main() {
+static BDD bdd_no_paralelo(GerenciadorBDD *ger, TrabalhadorBDD *t, int var_idx, BDD no_sim, BDD no_nao)
+{
+    if (no_sim == no_nao) return no_sim;
+    if (BDD_EH_COMPLEMENTO(no_sim)) {
+        return BDD_COMPLEMENTO(bdd_no_paralelo(ger, t, var_idx, BDD_COMPLEMENTO(no_sim), BDD_COMPLEMENTO(no_nao)));
+    }
+
+    SubtabelaBDD *st = &ger->subtabelas[var_idx];
+    uint32_t *balde = &st->baldes[bdd_hash(no_sim, no_nao, st->tam)];
+    uint32_t cabeca = __atomic_load_n(balde, __ATOMIC_ACQUIRE);
+    for (uint32_t i = cabeca; i != 0; i = ger->nos[i].prox) {
+        if (ger->nos[i].sim == no_sim && ger->nos[i].nao == no_nao) return i << 1;
+    }
+
+    if (t->livres == 0 && !bdd_reservar_lote(ger, t)) {
+        atomic_store(&t->pool->falhou, 1);
+        return ger->zero;
+    }
+    uint32_t novo = t->livres;
+    NoBDD *no = &ger->nos[novo];
+    t->livres = no->prox;
+    no->var_idx = var_idx;
+    no->sim = no_sim;
+    no->nao = no_nao;
+
+    uint32_t conferido = cabeca;  // Daqui para baixo a lista já foi conferida
+    for (;;) {
+        no->prox = cabeca;
+        if (__atomic_compare_exchange_n(balde, &cabeca, novo, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) break;
+        for (uint32_t i = cabeca; i != conferido; i = ger->nos[i].prox) {
+            if (ger->nos[i].sim == no_sim && ger->nos[i].nao == no_nao) {
+                no->var_idx = VAR_LIVRE;  // Outra thread ganhou: o índice volta para a reserva
+                no->prox = t->livres;
+                t->livres = novo;
+                return i << 1;
+            }
+        }
+        conferido = cabeca;
+    }
+    t->criados++;
+
+    // Listas longas demais: refaz a operação depois de redimensionar
+    if (__atomic_add_fetch(&st->num, 1, __ATOMIC_RELAXED) > 2 * st->tam) {
+        atomic_store(&t->pool->falhou, 1);
+    }
+    return novo << 1;
+}
+
+// Só o ITE roda em paralelo, então estas duas só tratam entradas OP_ITE
+static int bdd_cache_ler_paralelo(EntradaCache *e, BDD f, BDD g, BDD h, BDD *resultado)
+{
+    uint32_t versao = __atomic_load_n(&e->versao, __ATOMIC_ACQUIRE);
+    if (versao & 1) return 0;
+    uint32_t op = __atomic_load_n(&e->op, __ATOMIC_RELAXED);
+    BDD ef = __atomic_load_n(&e->f, __ATOMIC_RELAXED);
+    BDD eg = __atomic_load_n(&e->g, __ATOMIC_RELAXED);
+    BDD eh = __atomic_load_n(&e->h, __ATOMIC_RELAXED);
+    BDD er = __atomic_load_n(&e->resultado, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&e->versao, __ATOMIC_RELAXED) != versao) return 0;
+    if (op != OP_ITE || ef != f || eg != g || eh != h) return 0;
+    *resultado = er;
+    return 1;
+}
+
+static void bdd_cache_gravar_paralelo(EntradaCache *e, BDD f, BDD g, BDD h, BDD resultado)
+{
+    uint32_t versao = __atomic_load_n(&e->versao, __ATOMIC_RELAXED);
+    // Entrada ocupada por outra escrita: esta se perde (a cache já é com perdas)
+    if ((versao & 1) || !__atomic_compare_exchange_n(&e->versao, &versao, versao + 1, 0,
+                                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&e->op, OP_ITE, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->f, f, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->g, g, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->h, h, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->resultado, resultado, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->versao, versao + 2, __ATOMIC_RELEASE);
+}
+
+static BDD bdd_ite_par(GerenciadorBDD *ger, TrabalhadorBDD *t, BDD f, BDD g, BDD h, int profundidade);
+
+/**
+ * Rouba uma tarefa de alguma outra thread e a executa
+ * Retorna: 0 se não achou nenhuma
+ */
+static int bdd_roubar(GerenciadorBDD *ger, TrabalhadorBDD *t)
+{
+    PoolBDD *P = t->pool;
+    int inicio = rand_r(&t->semente) % P->num;
+    for (int k = 0; k < P->num; k++) {
+        int v = (inicio + k) % P->num;
+        if (v == t->id) continue;
+        TarefaITE *tarefa = bdd_tirar_do_inicio(&P->filas[v]);
+        if (tarefa == NULL) continue;
+        tarefa->resultado = bdd_ite_par(ger, t, tarefa->f, tarefa->g, tarefa->h, tarefa->profundidade);
+        atomic_store_explicit(&tarefa->estado, 2, memory_order_release);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Resultado de uma tarefa empilhada pela própria thread: executa ela mesma se
+ * ninguém roubou; senão ajuda com outras tarefas enquanto espera
+ */
+static BDD bdd_juntar(GerenciadorBDD *ger, TrabalhadorBDD *t, TarefaITE *tarefa)
+{
+    if (bdd_retomar_tarefa(&t->pool->filas[t->id], tarefa)) {
+        return bdd_ite_par(ger, t, tarefa->f, tarefa->g, tarefa->h, tarefa->profundidade);
+    }
+    while (atomic_load_explicit(&tarefa->estado, memory_order_acquire) != 2) {
+        if (!bdd_roubar(ger, t)) sched_yield();
+    }
+    return tarefa->resultado;
+}
+
+/**
+ * Recursão do ITE paralelo: a mesma de bdd_ite_rec, com tarefas e estruturas concorrentes
+ * Depois de uma falha devolve lixo (FALSO) sem guardar nada: a operação será refeita
+ */
+static BDD bdd_ite_par(GerenciadorBDD *ger, TrabalhadorBDD *t, BDD f, BDD g, BDD h, int profundidade)
+{
+    int negar;
+    BDD resultado;
+    if (bdd_ite_normalizar(ger, &f, &g, &h, &negar, &resultado)) return resultado;
+    if (atomic_load_explicit(&t->pool->falhou, memory_order_relaxed)) return ger->zero;
+
+    EntradaCache *e = bdd_cache_entrada(ger, OP_ITE, f, g, h);
+    t->consultas++;
+    if (bdd_cache_ler_paralelo(e, f, g, h, &resultado)) {
+        t->acertos++;
+        return negar ? BDD_COMPLEMENTO(resultado) : resultado;
+    }
+
+    int nivel = bdd_topo(ger, f);
+    if (bdd_topo(ger, g) < nivel) nivel = bdd_topo(ger, g);
+    if (bdd_topo(ger, h) < nivel) nivel = bdd_topo(ger, h);
+    int var_idx = ger->var_do_nivel[nivel];
+
+    BDD no_sim, no_nao;
+    if (profundidade < PROFUNDIDADE_TAREFAS) {
+        TarefaITE tarefa;
+        tarefa.f = bdd_cofator(ger, f, var_idx, 1);
+        tarefa.g = bdd_cofator(ger, g, var_idx, 1);
+        tarefa.h = bdd_cofator(ger, h, var_idx, 1);
+        tarefa.profundidade = profundidade + 1;
+        atomic_init(&tarefa.estado, 0);
+        bdd_empilhar_tarefa(&t->pool->filas[t->id], &tarefa);
+        no_nao = bdd_ite_par(ger, t, bdd_cofator(ger, f, var_idx, 0), bdd_cofator(ger, g, var_idx, 0),
+                             bdd_cofator(ger, h, var_idx, 0), profundidade + 1);
+        no_sim = bdd_juntar(ger, t, &tarefa);
+    }
+    else {
+        no_sim = bdd_ite_par(ger, t, bdd_cofator(ger, f, var_idx, 1), bdd_cofator(ger, g, var_idx, 1),
+                             bdd_cofator(ger, h, var_idx, 1), profundidade + 1);
+        no_nao = bdd_ite_par(ger, t, bdd_cofator(ger, f, var_idx, 0), bdd_cofator(ger, g, var_idx, 0),
+                             bdd_cofator(ger, h, var_idx, 0), profundidade + 1);
+    }
+    if (atomic_load_explicit(&t->pool->falhou, memory_order_relaxed)) return ger->zero;
+
+    resultado = bdd_no_paralelo(ger, t, var_idx, no_sim, no_nao);
+    if (atomic_load_explicit(&t->pool->falhou, memory_order_relaxed)) return ger->zero;
+    bdd_cache_gravar_paralelo(e, f, g, h, resultado);
+    return negar ? BDD_COMPLEMENTO(resultado) : resultado;
+}
+
+/**
+ * Laço das threads auxiliares: dormem entre operações e roubam tarefas durante elas
+ */
+static void *bdd_trabalhador(void *arg)
+{
+    TrabalhadorBDD *t = (TrabalhadorBDD*)arg;
+    PoolBDD *P = t->pool;
+    for (;;) {
+        pthread_mutex_lock(&P->trava);
+        while (!atomic_load(&P->ativo) && !atomic_load(&P->encerrar)) {
+            pthread_cond_wait(&P->acordar, &P->trava);
+        }
+        pthread_mutex_unlock(&P->trava);
+        if (atomic_load(&P->encerrar)) return NULL;
+
+        // Quem chamou a operação só volta ao código sequencial com em_operacao = 0
+        atomic_fetch_add(&P->em_operacao, 1);
+        while (atomic_load(&P->ativo)) {
+            if (!bdd_roubar(P->ger, t)) sched_yield();
+        }
+        atomic_fetch_sub(&P->em_operacao, 1);
+    }
+}
+
+/**
+ * ITE de topo com as threads do pool
+ */
+static BDD bdd_ite_paralelo(GerenciadorBDD *ger, BDD f, BDD g, BDD h)
+{
+    PoolBDD *P = ger->pool;
+    for (;;) {
+        // Folga para a operação: arena com pelo menos metade dos nós vivos livre
+        // e subtabelas no máximo meio cheias (elas só desistem com o dobro)
+        while (ger->cap_nos - ger->usados < ger->vivos / 2 + (uint32_t)P->num * LOTE_NOS) {
+            bdd_crescer_arena(ger);
+        }
+        for (int v = 0; v < ger->cont_vars; v++) {
+            while (ger->subtabelas[v].num > ger->subtabelas[v].tam / 2) {
+                bdd_redimensionar(ger, &ger->subtabelas[v]);
+            }
+        }
+
+        atomic_store(&P->falhou, 0);
+        pthread_mutex_lock(&P->trava);
+        atomic_store(&P->ativo, 1);
+        pthread_cond_broadcast(&P->acordar);
+        pthread_mutex_unlock(&P->trava);
+
+        BDD resultado = bdd_ite_par(ger, &P->trab[0], f, g, h, 0);
+
+        atomic_store(&P->ativo, 0);
+        while (atomic_load(&P->em_operacao) > 0) sched_yield();
+
+        for (int k = 0; k < P->num; k++) {
+            TrabalhadorBDD *t = &P->trab[k];
+            ger->criados += t->criados;
+            ger->vivos += t->criados;
+            ger->consultas_cache += t->consultas;
+            ger->acertos_cache += t->acertos;
+            t->criados = t->consultas = t->acertos = 0;
+        }
+        if (ger->vivos > ger->pico_vivos) ger->pico_vivos = ger->vivos;
+        if (!atomic_load(&P->falhou)) return resultado;
+
+        // Faltou espaço: cresce e tenta de novo
+        if (ger->cap_nos - ger->usados < ger->cap_nos / 4) bdd_crescer_arena(ger);
+    }
+}
+
+/**
+ * Define quantas threads calculam cada operação (1 = sequencial)
+ * O pool fica criado até a próxima chamada ou até bdd_liberar.
+ */
+void bdd_usar_threads(GerenciadorBDD *ger, int num)
+{
+    PoolBDD *P = ger->pool;
+    if (P != NULL) {
+        pthread_mutex_lock(&P->trava);
+        atomic_store(&P->encerrar, 1);
+        pthread_cond_broadcast(&P->acordar);
+        pthread_mutex_unlock(&P->trava);
+        for (int k = 1; k < P->num; k++) pthread_join(P->threads[k], NULL);
+
+        // Índices ainda reservados voltam para a lista livre
+        for (int k = 0; k < P->num; k++) {
+            while (P->trab[k].livres != 0) {
+                uint32_t i = P->trab[k].livres;
+                P->trab[k].livres = ger->nos[i].prox;
+                ger->nos[i].prox = ger->livres;
+                ger->livres = i;
+            }
+            pthread_mutex_destroy(&P->filas[k].trava);
+            free(P->filas[k].itens);
+        }
+        pthread_mutex_destroy(&P->trava);
+        pthread_mutex_destroy(&P->trava_arena);
+        pthread_cond_destroy(&P->acordar);
+        free(P->threads);
+        free(P->trab);
+        free(P->filas);
+        free(P);
+        ger->pool = NULL;
+    }
+    if (num <= 1) return;
+
+    P = (PoolBDD*)malloc(sizeof(PoolBDD));
+    P->ger = ger;
+    P->num = num;
+    P->threads = (pthread_t*)malloc(num * sizeof(pthread_t));
+    P->trab = (TrabalhadorBDD*)calloc(num, sizeof(TrabalhadorBDD));
+    P->filas = (FilaTarefas*)malloc(num * sizeof(FilaTarefas));
+    pthread_mutex_init(&P->trava, NULL);
+    pthread_mutex_init(&P->trava_arena, NULL);
+    pthread_cond_init(&P->acordar, NULL);
+    atomic_init(&P->ativo, 0);
+    atomic_init(&P->encerrar, 0);
+    atomic_init(&P->em_operacao, 0);
+    atomic_init(&P->falhou, 0);
+    for (int k = 0; k < num; k++) {
+        P->trab[k].pool = P;
+        P->trab[k].id = k;
+        P->trab[k].semente = 12345u + 7919u * k;
+        pthread_mutex_init(&P->filas[k].trava, NULL);
+        P->filas[k].cap = 64;
+        P->filas[k].itens = (TarefaITE**)malloc(P->filas[k].cap * sizeof(TarefaITE*));
+        P->filas[k].inicio = P->filas[k].fim = 0;
+    }
+    ger->pool = P;
+    for (int k = 1; k < num; k++) pthread_create(&P->threads[k], NULL, bdd_trabalhador, &P->trab[k]);
+}
+
+/**
+ * Operador ITE (if-then-else): ite(f, g, h) = (f E g) OU (NAO f E h)
+ * Todas as operações booleanas são casos particulares dele, e por isso todas
+ * compartilham a mesma cache de resultados
+ */
+BDD bdd_ite(GerenciadorBDD *ger, BDD f, BDD g, BDD h)
+{
+    bdd_ponto_seguro(ger, f, g, h);
+    if (ger->pool != NULL) return bdd_ite_paralelo(ger, f, g, h);
+    return bdd_ite_rec(ger, f, g, h);
+}
+
+/**
+ * Operação NOT (NÃO): com arestas complementadas é só trocar o bit, O(1)
+ */
+BDD bdd_nao(GerenciadorBDD *ger, BDD f)
+{
+    (void)ger;
+    return BDD_COMPLEMENTO(f);
+}
+
+/**
+ * Operação AND (E) entre dois BDDs: ite(f, g, 0)
+ */
+BDD bdd_e(GerenciadorBDD *ger, BDD f, BDD g)
+{
+    return bdd_ite(ger, f, g, ger->zero);
+}
+
+/**
+ * Operação OR (OU) entre dois BDDs: ite(f, 1, g)
+ */
+BDD bdd_ou(GerenciadorBDD *ger, BDD f, BDD g)
+{
+    return bdd_ite(ger, f, ger->um, g);
+}
+
+/**
+ * Operação XOR (OU exclusivo): ite(f, NÃO g, g)
+ */
+BDD bdd_xou(GerenciadorBDD *ger, BDD f, BDD g)
+{
+    return bdd_ite(ger, f, BDD_COMPLEMENTO(g), g);
+}
+
+/**
+ * Implicação f -> g: ite(f, g, 1)
+ */
+BDD bdd_implica(GerenciadorBDD *ger, BDD f, BDD g)
+{
+    return bdd_ite(ger, f, g, ger->um);
+}
+
+/**
+ * Multiplexador: se s então a senão b
+ */
+BDD bdd_mux(GerenciadorBDD *ger, BDD s, BDD a, BDD b)
+{
+    return bdd_ite(ger, s, a, b);
+}
+
+// ==================== QUANTIFICAÇÃO E RENOMEAÇÃO ====================
+//
+// Conjuntos de variáveis são passados como cubos: a conjunção das variáveis,
+// montada por bdd_cubo. Como todo cubo é uma cadeia de ramos SIM, percorrê-lo junto
+// com f é só descer pelo SIM enquanto a variável do cubo estiver acima de f.
+
+/**
+ * Cubo (conjunção) das variáveis dadas, para usar como conjunto nas quantificações
+ */
+BDD bdd_cubo(GerenciadorBDD *ger, const int *vars, int num_vars)
+{
+    BDD cubo = bdd_ref(ger, ger->um);
+    for (int k = 0; k < num_vars; k++) {
+        BDD novo = bdd_ref(ger, bdd_e(ger, cubo, bdd_variavel(ger, vars[k])));
+        bdd_deref(ger, cubo);
+        cubo = novo;
+    }
+    bdd_deref(ger, cubo);
+    return cubo;
+}
+
+/**
+ * Tira do cubo as variáveis acima do nível dado (f não depende delas)
+ */
+static BDD bdd_cubo_abaixo(GerenciadorBDD *ger, BDD cubo, int nivel)
+{
+    while (cubo != ger->um && bdd_topo(ger, cubo) < nivel) cubo = ger->nos[BDD_INDICE(cubo)].sim;
+    return cubo;
+}
+
+static BDD bdd_existe_rec(GerenciadorBDD *ger, BDD f, BDD cubo)
+{
+    if (BDD_INDICE(f) == 0) return f;
+    cubo = bdd_cubo_abaixo(ger, cubo, bdd_topo(ger, f));
+    if (cubo == ger->um) return f;
+
+    EntradaCache *e = bdd_cache_entrada(ger, OP_EXISTE, f, cubo, 0);
+    ger->consultas_cache++;
+    if (e->op == OP_EXISTE && e->f == f && e->g == cubo && e->h == 0) {
+        ger->acertos_cache++;
+        return e->resultado;
+    }
+
+    int var_idx = ger->nos[BDD_INDICE(f)].var_idx;
+    BDD resultado;
+    if (ger->nos[BDD_INDICE(cubo)].var_idx == var_idx) {
+        // Variável quantificada: existe v. f = f[v=1] OU f[v=0]
+        BDD resto = ger->nos[BDD_INDICE(cubo)].sim;
+        BDD r1 = bdd_existe_rec(ger, bdd_cofator(ger, f, var_idx, 1), resto);
+        resultado = r1 == ger->um ? r1
+                  : bdd_ite_rec(ger, r1, ger->um, bdd_existe_rec(ger, bdd_cofator(ger, f, var_idx, 0), resto));
+    }
+    else {
+        BDD r1 = bdd_existe_rec(ger, bdd_cofator(ger, f, var_idx, 1), cubo);
+        BDD r0 = bdd_existe_rec(ger, bdd_cofator(ger, f, var_idx, 0), cubo);
+        resultado = bdd_encontrar_ou_criar_no(ger, var_idx, r1, r0);
+    }
+
+    e->op = OP_EXISTE;
+    e->f = f;
+    e->g = cubo;
+    e->h = 0;
+    e->resultado = resultado;
+    return resultado;
+}
+
+/**
+ * Quantificação existencial: existe (variáveis do cubo). f
+ */
+BDD bdd_existe(GerenciadorBDD *ger, BDD f, BDD cubo)
+{
+    bdd_ponto_seguro(ger, f, cubo, ger->um);
+    return bdd_existe_rec(ger, f, cubo);
+}
+
+/**
+ * Quantificação universal: para todo (variáveis do cubo). f = NÃO existe. NÃO f
+ */
+BDD bdd_para_todo(GerenciadorBDD *ger, BDD f, BDD cubo)
+{
+    return BDD_COMPLEMENTO(bdd_existe(ger, BDD_COMPLEMENTO(f), cubo));
+}
+
+static BDD bdd_e_existe_rec(GerenciadorBDD *ger, BDD f, BDD g, BDD cubo)
+{
+    // Casos terminais
+    if (f == ger->zero || g == ger->zero || f == BDD_COMPLEMENTO(g)) return ger->zero;
+    if (f == ger->um) return bdd_existe_rec(ger, g, cubo);
+    if (g == ger->um || f == g) return bdd_existe_rec(ger, f, cubo);
+    if (cubo == ger->um) return bdd_ite_rec(ger, f, g, ger->zero);
+    if (f > g) {  // E é comutativo: uma ordem fixa aproveita melhor a cache
+        BDD t = f;
+        f = g;
+        g = t;
+    }
+
+    int nivel = bdd_topo(ger, f) < bdd_topo(ger, g) ? bdd_topo(ger, f) : bdd_topo(ger, g);
+    cubo = bdd_cubo_abaixo(ger, cubo, nivel);
+    if (cubo == ger->um) return bdd_ite_rec(ger, f, g, ger->zero);
+
+    EntradaCache *e = bdd_cache_entrada(ger, OP_E_EXISTE, f, g, cubo);
+    ger->consultas_cache++;
+    if (e->op == OP_E_EXISTE && e->f == f && e->g == g && e->h == cubo) {
+        ger->acertos_cache++;
+        return e->resultado;
+    }
+
+    int var_idx = ger->var_do_nivel[nivel];
+    BDD resultado;
+    if (bdd_topo(ger, cubo) == nivel) {
+        // Quantifica já: o produto f E g neste nível nunca é construído
+        BDD resto = ger->nos[BDD_INDICE(cubo)].sim;
+        BDD r1 = bdd_e_existe_rec(ger, bdd_cofator(ger, f, var_idx, 1), bdd_cofator(ger, g, var_idx, 1), resto);
+        if (r1 == ger->um) {
+            resultado = r1;
+        }
+        else {
+            BDD r0 = bdd_e_existe_rec(ger, bdd_cofator(ger, f, var_idx, 0), bdd_cofator(ger, g, var_idx, 0), resto);
+            resultado = bdd_ite_rec(ger, r1, ger->um, r0);
+        }
+    }
+    else {
+        BDD r1 = bdd_e_existe_rec(ger, bdd_cofator(ger, f, var_idx, 1), bdd_cofator(ger, g, var_idx, 1), cubo);
+        BDD r0 = bdd_e_existe_rec(ger, bdd_cofator(ger, f, var_idx, 0), bdd_cofator(ger, g, var_idx, 0), cubo);
+        resultado = bdd_encontrar_ou_criar_no(ger, var_idx, r1, r0);
+    }
+
+    e->op = OP_E_EXISTE;
+    e->f = f;
+    e->g = g;
+    e->h = cubo;
+    e->resultado = resultado;
+    return resultado;
+}
+
+/**
+ * Produto relacional: existe (variáveis do cubo). (f E g), numa passada só
+ * É a operação de imagem da verificação de modelos: estados E transições,
+ * quantificando o estado atual
+ */
+BDD bdd_e_existe(GerenciadorBDD *ger, BDD f, BDD g, BDD cubo)
+{
+    bdd_ponto_seguro(ger, f, g, cubo);
+    return bdd_e_existe_rec(ger, f, g, cubo);
+}
+
+static BDD bdd_renomear_rec(GerenciadorBDD *ger, BDD f)
+{
+    if (BDD_INDICE(f) == 0) return f;
+
+    uint32_t op = OP_RENOMEAR | (ger->num_mapa << 2);
+    EntradaCache *e = bdd_cache_entrada(ger, op, f, 0, 0);
+    ger->consultas_cache++;
+    if (e->op == op && e->f == f && e->g == 0 && e->h == 0) {
+        ger->acertos_cache++;
+        return e->resultado;
+    }
+
+    // A variável nova pode estar em outro nível: o ITE recoloca tudo na ordem
+    int var_idx = ger->nos[BDD_INDICE(f)].var_idx;
+    BDD r1 = bdd_renomear_rec(ger, bdd_cofator(ger, f, var_idx, 1));
+    BDD r0 = bdd_renomear_rec(ger, bdd_cofator(ger, f, var_idx, 0));
+    BDD resultado = bdd_ite_rec(ger, ger->vars[ger->mapa[var_idx]], r1, r0);
+
+    e->op = op;
+    e->f = f;
+    e->g = 0;
+    e->h = 0;
+    e->resultado = resultado;
+    return resultado;
+}
+
+/**
+ * Troca cada variável v de f por mapa[v] (mapa tem uma posição por variável
+ * existente; use mapa[v] = v para as que ficam)
+ * Serve para passar do estado seguinte para o atual depois de uma imagem
+ */
+BDD bdd_renomear(GerenciadorBDD *ger, BDD f, const int *mapa)
+{
+    bdd_ponto_seguro(ger, f, ger->um, ger->um);
+    if (ger->mapa == NULL || ger->tam_mapa != ger->cont_vars ||
+        memcmp(ger->mapa, mapa, ger->cont_vars * sizeof(int)) != 0) {
+        ger->mapa = (int*)realloc(ger->mapa, ger->cont_vars * sizeof(int));
+        memcpy(ger->mapa, mapa, ger->cont_vars * sizeof(int));
+        ger->tam_mapa = ger->cont_vars;
+        ger->num_mapa++;
+    }
+    return bdd_renomear_rec(ger, f);
+}
+
+// ==================== CONTAGEM E ENUMERAÇÃO ====================
+
+// Memória da contagem: índice do nó -> modelos do nó regular (endereçamento aberto)
+typedef struct {
+    uint32_t *chaves;   // Índice do nó + 1 (0 = vazio)
+    double *valores;
+    uint32_t tam, num;
+} MemoContagem;
+
+static double *bdd_memo_lugar(MemoContagem *memo, uint32_t i, int *novo)
+{
+    if (2 * (memo->num + 1) > memo->tam) {
+        MemoContagem maior = { (uint32_t*)calloc(2 * memo->tam, sizeof(uint32_t)),
+                               (double*)malloc(2 * memo->tam * sizeof(double)), 2 * memo->tam, memo->num };
+        for (uint32_t k = 0; k < memo->tam; k++) {
+            if (memo->chaves[k] == 0) continue;
+            uint32_t h = (memo->chaves[k] * 2654435761u) & (maior.tam - 1);
+            while (maior.chaves[h] != 0) h = (h + 1) & (maior.tam - 1);
+            maior.chaves[h] = memo->chaves[k];
+            maior.valores[h] = memo->valores[k];
+        }
+        free(memo->chaves);
+        free(memo->valores);
+        *memo = maior;
+    }
+    uint32_t h = ((i + 1) * 2654435761u) & (memo->tam - 1);
+    while (memo->chaves[h] != 0 && memo->chaves[h] != i + 1) h = (h + 1) & (memo->tam - 1);
+    *novo = memo->chaves[h] == 0;
+    if (*novo) {
+        memo->chaves[h] = i + 1;
+        memo->num++;
+    }
+    return &memo->valores[h];
+}
+
+// Nível de f na contagem: a constante fica no nível n, abaixo de todas as variáveis
+static int bdd_nivel_contagem(GerenciadorBDD *ger, BDD f)
+{
+    return BDD_INDICE(f) == 0 ? ger->cont_vars : ger->nivel_da_var[ger->nos[BDD_INDICE(f)].var_idx];
+}
+
+/**
+ * Modelos de f contando só as variáveis dos níveis topo(f) .. n-1
+ * Cada nó é calculado uma vez (a memória guarda o valor do nó regular, e o
+ * complemento é 2^(variáveis abaixo) menos ele), então o custo é linear no BDD
+ */
+static double bdd_contar_rec(GerenciadorBDD *ger, BDD f, MemoContagem *memo)
+{
+    uint32_t i = BDD_INDICE(f);
+    int nivel = bdd_nivel_contagem(ger, f);
+    double regular;
+    if (i == 0) {
+        regular = 1;
+    }
+    else {
+        int novo;
+        double *lugar = bdd_memo_lugar(memo, i, &novo);
+        if (novo) {
+            BDD sim = ger->nos[i].sim, nao = ger->nos[i].nao;
+            double c1 = bdd_contar_rec(ger, sim, memo);
+            double c0 = bdd_contar_rec(ger, nao, memo);
+            // Variáveis puladas entre o nó e cada filho valem qualquer coisa
+            regular = ldexp(c1, bdd_nivel_contagem(ger, sim) - nivel - 1)
+                    + ldexp(c0, bdd_nivel_contagem(ger, nao) - nivel - 1);
+            lugar = bdd_memo_lugar(memo, i, &novo);  // A recursão pode ter redimensionado a memória
+            *lugar = regular;
+        }
+        else {
+            regular = *lugar;
+        }
+    }
+    return BDD_EH_COMPLEMENTO(f) ? ldexp(1, ger->cont_vars - nivel) - regular : regular;
+}
+
+/**
+ * Número de atribuições das variáveis do gerenciador que satisfazem f
+ * Em double: exato até 2^53, aproximado acima disso
+ */
+double bdd_contar(GerenciadorBDD *ger, BDD f)
+{
+    MemoContagem memo = { (uint32_t*)calloc(64, sizeof(uint32_t)), (double*)malloc(64 * sizeof(double)), 64, 0 };
+    double c = ldexp(bdd_contar_rec(ger, f, &memo), bdd_nivel_contagem(ger, f));
+    free(memo.chaves);
+    free(memo.valores);
+    return c;
+}
+
+/**
+ * Número de nós alcançáveis a partir de raizes[0..n-1], sem contar a constante
+ * (diferente de ger->vivos, que inclui o lixo ainda não recolhido)
+ */
+uint32_t bdd_tamanho(GerenciadorBDD *ger, const BDD *raizes, int n)
+{
+    uint8_t *marca = (uint8_t*)calloc(ger->usados, 1);
+    uint32_t cap = 64;
+    uint32_t *pilha = (uint32_t*)malloc(cap * sizeof(uint32_t));
+    for (int r = 0; r < n; r++) bdd_marcar(ger, marca, &pilha, &cap, raizes[r]);
+    uint32_t total = 0;
+    for (uint32_t i = 1; i < ger->usados; i++) total += marca[i];
+    free(pilha);
+    free(marca);
+    return total;
+}
+
+// Iterador preguiçoso sobre os cubos (caminhos até 1) de um BDD
+// Num BDD reduzido, toda aresta diferente de FALSO leva a pelo menos um caminho até
+// 1, então a busca nunca desce por um ramo sem saída: cada cubo sai em O(variáveis)
+typedef struct {
+    GerenciadorBDD *ger;
+    BDD raiz;
+    BDD *arestas;       // Aresta em cada profundidade do caminho atual
+    int *vars;          // Variável testada em cada profundidade
+    signed char *cubo;  // Valor de cada variável no cubo atual (-1 = tanto faz)
+    int prof;
+    int pronto;         // Há um cubo pronto para ser entregue
+} IteradorCubos;
+
+/**
+ * Desce pelo ramo SIM sempre que ele não for FALSO, até a constante 1
+ */
+static void bdd_iterador_descer(IteradorCubos *it, BDD f)
+{
+    GerenciadorBDD *ger = it->ger;
+    while (BDD_INDICE(f) != 0) {
+        int v = ger->nos[BDD_INDICE(f)].var_idx;
+        BDD f1 = bdd_cofator(ger, f, v, 1);
+        it->arestas[it->prof] = f;
+        it->vars[it->prof++] = v;
+        if (f1 != ger->zero) {
+            it->cubo[v] = 1;
+            f = f1;
+        }
+        else {
+            it->cubo[v] = 0;
+            f = bdd_cofator(ger, f, v, 0);
+        }
+    }
+}
+
+/**
+ * Começa a enumerar os cubos de f (f fica referenciado até bdd_iterador_liberar)
+ * Enquanto o iterador existir não se deve reordenar as variáveis
+ */
+void bdd_iterador_iniciar(IteradorCubos *it, GerenciadorBDD *ger, BDD f)
+{
+    it->ger = ger;
+    it->raiz = bdd_ref(ger, f);
+    it->arestas = (BDD*)malloc((ger->cont_vars + 1) * sizeof(BDD));
+    it->vars = (int*)malloc((ger->cont_vars + 1) * sizeof(int));
+    it->cubo = (signed char*)malloc(ger->cont_vars + 1);
+    memset(it->cubo, -1, ger->cont_vars + 1);
+    it->prof = 0;
+    it->pronto = f != ger->zero;
+    if (it->pronto) bdd_iterador_descer(it, f);
+}
+
+/**
+ * Próximo cubo: cubo[v] recebe 1, 0 ou -1 (tanto faz) para cada variável
+ * Retorna: 0 quando os cubos acabaram
+ */
+int bdd_proximo_cubo(IteradorCubos *it, signed char *cubo)
+{
+    if (!it->pronto) return 0;
+    memcpy(cubo, it->cubo, it->ger->cont_vars);
+
+    // Prepara o seguinte: volta até um nível em que o caminho foi pelo SIM e o NÃO não é FALSO
+    it->pronto = 0;
+    while (it->prof > 0) {
+        int k = it->prof - 1;
+        int v = it->vars[k];
+        BDD f0 = bdd_cofator(it->ger, it->arestas[k], v, 0);
+        if (it->cubo[v] == 1 && f0 != it->ger->zero) {
+            it->cubo[v] = 0;
+            bdd_iterador_descer(it, f0);
+            it->pronto = 1;
+            break;
+        }
+        it->cubo[v] = -1;
+        it->prof--;
+    }
+    return 1;
+}
+
+void bdd_iterador_liberar(IteradorCubos *it)
+{
+    bdd_deref(it->ger, it->raiz);
+    free(it->arestas);
+    free(it->vars);
+    free(it->cubo);
+}
+
+// ==================== SERIALIZAÇÃO ====================
+//
+// Formato binário (todos os números em varint LEB128, sem depender de endianness):
+//   "BDD1"
+//   assinatura de 64 bits (8 bytes, do menos para o mais significativo) de quem gravou,
+//     para o leitor saber se o arquivo ainda corresponde aos dados de origem
+//   número de variáveis, de nós e de raízes
+//   nomes das variáveis na ordem dos níveis, cada um terminado em '\0'
+//   para cada nó, filhos antes dos pais: posição da variável na lista acima,
+//     ramo SIM e ramo NÃO como ((k - j) << 1) | complemento, em que k é o número
+//     do nó (1, 2, ...) e j o do filho (0 = constante 1)
+//   para cada raiz: (j << 1) | complemento
+// As diferenças k - j costumam ser pequenas e cabem em um ou dois bytes.
+
+static void bdd_gravar_varint(FILE *arq, uint32_t v)
+{
+    while (v >= 0x80) {
+        putc((int)(v & 0x7f) | 0x80, arq);
+        v >>= 7;
+    }
+    putc((int)v, arq);
+}
+
+static int bdd_ler_varint(const uint8_t **p, const uint8_t *fim, uint32_t *v)
+{
+    *v = 0;
+    for (int desloc = 0; desloc < 35; desloc += 7) {
+        if (*p == fim) return 0;
+        uint8_t b = *(*p)++;
+        *v |= (uint32_t)(b & 0x7f) << desloc;
+        if (!(b & 0x80)) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Grava os BDDs raizes[0..n-1] (com a ordem atual das variáveis) em um arquivo
+ * assinatura: identifica a origem dos BDDs (0 se não importar); bdd_carregar a confere
+ * Retorna: tamanho do arquivo em bytes, ou -1 em caso de erro
+ */
+long bdd_salvar(GerenciadorBDD *ger, const char *caminho, const BDD *raizes, int n, uint64_t assinatura)
+{
+    FILE *arq = fopen(caminho, "wb");
+    if (arq == NULL) {
+        printf("Erro: nao foi possivel criar %s.\n", caminho);
+        return -1;
+    }
+
+    // Numera os nós em pós-ordem (pilha explícita, como na marcação do coletor)
+    uint32_t *numero = (uint32_t*)calloc(ger->usados, sizeof(uint32_t));
+    uint32_t *ordem = (uint32_t*)malloc(64 * sizeof(uint32_t));
+    uint32_t cap_ordem = 64, num_nos = 0;
+    uint32_t cap = 64, topo = 0;
+    uint32_t *pilha = (uint32_t*)malloc(cap * sizeof(uint32_t));
+    for (int r = 0; r < n; r++) {
+        pilha[topo++] = BDD_INDICE(raizes[r]);
+        while (topo > 0) {
+            uint32_t i = pilha[topo - 1];
+            if (i == 0 || numero[i] != 0) {
+                topo--;
+                continue;
+            }
+            uint32_t s = BDD_INDICE(ger->nos[i].sim), t = BDD_INDICE(ger->nos[i].nao);
+            int prontos = 1;
+            if (topo + 2 > cap) {
+                cap *= 2;
+                pilha = (uint32_t*)realloc(pilha, cap * sizeof(uint32_t));
+            }
+            if (s != 0 && numero[s] == 0) { pilha[topo++] = s; prontos = 0; }
+            if (t != 0 && numero[t] == 0) { pilha[topo++] = t; prontos = 0; }
+            if (!prontos) continue;
+            topo--;
+            if (num_nos == cap_ordem) {
+                cap_ordem *= 2;
+                ordem = (uint32_t*)realloc(ordem, cap_ordem * sizeof(uint32_t));
+            }
+            ordem[num_nos++] = i;
+            numero[i] = num_nos;
+        }
+    }
+    free(pilha);
+
+    fwrite("BDD1", 1, 4, arq);
+    for (int b = 0; b < 8; b++) putc((int)((assinatura >> (8 * b)) & 0xff), arq);
+    bdd_gravar_varint(arq, (uint32_t)ger->cont_vars);
+    bdd_gravar_varint(arq, num_nos);
+    bdd_gravar_varint(arq, (uint32_t)n);
+    for (int nivel = 0; nivel < ger->cont_vars; nivel++) {
+        const char *nome = ger->nomes_vars[ger->var_do_nivel[nivel]];
+        fwrite(nome, 1, strlen(nome) + 1, arq);
+    }
+    for (uint32_t k = 1; k <= num_nos; k++) {
+        const NoBDD *no = &ger->nos[ordem[k - 1]];
+        bdd_gravar_varint(arq, (uint32_t)ger->nivel_da_var[no->var_idx]);
+        bdd_gravar_varint(arq, ((k - numero[BDD_INDICE(no->sim)]) << 1) | BDD_EH_COMPLEMENTO(no->sim));
+        bdd_gravar_varint(arq, ((k - numero[BDD_INDICE(no->nao)]) << 1) | BDD_EH_COMPLEMENTO(no->nao));
+    }
+    for (int r = 0; r < n; r++) {
+        bdd_gravar_varint(arq, (numero[BDD_INDICE(raizes[r])] << 1) | BDD_EH_COMPLEMENTO(raizes[r]));
+    }
+    free(numero);
+    free(ordem);
+
+    long tamanho = ftell(arq);
+    if (fclose(arq) != 0 || tamanho < 0) {
+        printf("Erro: falha ao gravar %s.\n", caminho);
+        return -1;
+    }
+    return tamanho;
+}
+
+/**
+ * Carrega os BDDs gravados por bdd_salvar, lendo direto do arquivo mapeado com mmap
+ * Variáveis com o mesmo nome são reaproveitadas; as que faltam são criadas no fim
+ * da ordem, na ordem gravada. Se a ordem do gerenciador concordar com a do
+ * arquivo, cada nó entra direto na tabela única; senão é refeito com ITE.
+ * assinatura: a passada a bdd_salvar; se a do arquivo for outra, nada é carregado
+ * num_raizes: recebe quantas raízes foram lidas
+ * Retorna: vetor com as raízes (referenciadas), ou NULL em caso de erro
+ */
+BDD *bdd_carregar(GerenciadorBDD *ger, const char *caminho, uint64_t assinatura, int *num_raizes)
+{
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro: nao foi possivel abrir %s.\n", caminho);
+        return NULL;
+    }
+    struct stat info;
+    void *mapa = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= 12) {
+        mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        printf("Erro: %s nao e um BDD gravado.\n", caminho);
+        return NULL;
+    }
+    const uint8_t *p = (const uint8_t*)mapa, *fim = p + info.st_size;
+
+    uint32_t num_vars = 0, num_nos = 0, n = 0;
+    int ok = memcmp(p, "BDD1", 4) == 0;
+    p += 4;
+    uint64_t gravada = 0;
+    for (int b = 0; b < 8; b++) gravada |= (uint64_t)*p++ << (8 * b);
+    if (ok && gravada != assinatura) {
+        // Checado antes de criar qualquer variável ou nó: o gerenciador fica intacto
+        printf("Aviso: %s foi gravado a partir de outra origem (assinatura diferente).\n", caminho);
+        munmap(mapa, (size_t)info.st_size);
+        return NULL;
+    }
+    ok = ok && bdd_ler_varint(&p, fim, &num_vars) && bdd_ler_varint(&p, fim, &num_nos) &&
+         bdd_ler_varint(&p, fim, &n);
+    // Cada nó ocupa pelo menos 3 bytes e cada variável 1, o que limita os tamanhos
+    ok = ok && num_vars <= (uint32_t)(fim - p) && num_nos <= (uint32_t)(fim - p) / 3 && n <= (uint32_t)(fim - p);
+    if (!ok) num_vars = num_nos = n = 0;
+
+    // Variáveis, e se a ordem delas no gerenciador é a mesma do arquivo
+    int *var_de = (int*)malloc((num_vars + 1) * sizeof(int));
+    int direto = 1;
+    for (uint32_t k = 0; ok && k < num_vars; k++) {
+        const uint8_t *nul = (const uint8_t*)memchr(p, '\0', (size_t)(fim - p));
+        if (nul == NULL) {
+            ok = 0;
+            break;
+        }
+        int v = bdd_procurar_var(ger, (const char*)p);
+        var_de[k] = v != -1 ? v : bdd_nova_var(ger, (const char*)p);
+        if (k > 0 && ger->nivel_da_var[var_de[k]] < ger->nivel_da_var[var_de[k - 1]]) direto = 0;
+        p = nul + 1;
+    }
+
+    // Nós: ids[k] é a aresta do k-ésimo nó lido (ids[0] = constante 1)
+    BDD *ids = (BDD*)malloc((num_nos + 1) * sizeof(BDD));
+    ids[0] = ger->um;
+    uint32_t lidos = 0;
+    while (ok && lidos < num_nos) {
+        uint32_t k = lidos + 1, pos, ds, dn;
+        ok = bdd_ler_varint(&p, fim, &pos) && bdd_ler_varint(&p, fim, &ds) && bdd_ler_varint(&p, fim, &dn) &&
+             pos < num_vars && (ds >> 1) >= 1 && (ds >> 1) <= k && (dn >> 1) >= 1 && (dn >> 1) <= k;
+        if (!ok) break;
+        BDD sim = ids[k - (ds >> 1)] ^ (ds & 1);
+        BDD nao = ids[k - (dn >> 1)] ^ (dn & 1);
+        int v = var_de[pos];
+        if (direto) {
+            // Filhos precisam estar abaixo do nó, senão o arquivo está corrompido
+            int nivel = ger->nivel_da_var[v];
+            ok = bdd_topo(ger, sim) > nivel && bdd_topo(ger, nao) > nivel;
+            if (!ok) break;
+            ids[k] = bdd_encontrar_ou_criar_no(ger, v, sim, nao);
+        }
+        else {
+            // Fora de ordem: ITE pode coletar lixo, então os nós já lidos ficam referenciados
+            ids[k] = bdd_ref(ger, bdd_ite(ger, bdd_variavel(ger, v), sim, nao));
+        }
+        lidos++;
+    }
+
+    BDD *raizes = NULL;
+    if (ok) {
+        raizes = (BDD*)malloc((n + 1) * sizeof(BDD));
+        for (uint32_t r = 0; r < n && ok; r++) {
+            uint32_t e;
+            ok = bdd_ler_varint(&p, fim, &e) && (e >> 1) <= num_nos;
+            if (ok) raizes[r] = ids[e >> 1] ^ (e & 1);
+        }
+        ok = ok && p == fim;
+        for (uint32_t r = 0; r < n && ok; r++) bdd_ref(ger, raizes[r]);
+    }
+    if (!direto) {
+        for (uint32_t k = 1; k <= lidos; k++) bdd_deref(ger, ids[k]);
+    }
+    free(ids);
+    free(var_de);
+    munmap(mapa, (size_t)info.st_size);
+
+    if (!ok) {
+        printf("Erro: %s esta corrompido.\n", caminho);
+        free(raizes);
+        return NULL;
+    }
+    *num_raizes = (int)n;
+    return raizes;
+}
+
+// ==================== VERIFICAÇÃO DE EQUIVALÊNCIA ====================
+
+/**
+ * Verifica se dois BDDs representam a mesma função booleana
+ * A canonicidade do BDD garante que funções equivalentes
+ * terão exatamente a mesma estrutura; como cada subgrafo existe uma
+ * única vez (tabela única), basta comparar as arestas
+ */
+int bdd_sao_equivalentes(BDD f, BDD g)
+{
+    return f == g;
+}
+
+/**
+ * Um caminho até a constante 1: preenche valores[v] (0 ou 1) para as variáveis
+ * do caminho e deixa as outras como estão
+ * Retorna: 0 se f é a constante FALSO (não há caminho)
+ */
+int bdd_um_caminho(GerenciadorBDD *ger, BDD f, int *valores)
+{
+    if (f == ger->zero) return 0;
+    // Em BDD reduzido, toda aresta diferente de FALSO leva a algum caminho até 1
+    while (BDD_INDICE(f) != 0) {
+        int v = ger->nos[BDD_INDICE(f)].var_idx;
+        BDD no_sim = bdd_cofator(ger, f, v, 1);
+        if (no_sim != ger->zero) {
+            valores[v] = 1;
+            f = no_sim;
+        }
+        else {
+            valores[v] = 0;
+            f = bdd_cofator(ger, f, v, 0);
+        }
+    }
+    return 1;
+}
+
+/**
+ * Valor de f quando cada variável v vale valores[v]
+ */
+int bdd_avaliar(GerenciadorBDD *ger, BDD f, const int *valores)
+{
+    while (BDD_INDICE(f) != 0) {
+        int v = ger->nos[BDD_INDICE(f)].var_idx;
+        f = bdd_cofator(ger, f, v, valores[v]);
+    }
+    return f == ger->um;
+}
+
+// ==================== NETLISTS (ISCAS .bench) ====================
+
+/**
+ * Tempo de relógio desde inicio (com várias threads, clock() somaria a CPU de todas)
+ */
+static double segundos_desde(const struct timespec *inicio)
+{
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)(agora.tv_sec - inicio->tv_sec) + (agora.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+// Tipos de porta aceitos no formato .bench
+typedef enum {
+    PORTA_INDEFINIDA,   // Sinal usado mas ainda não definido
+    PORTA_ENTRADA,      // INPUT(...)
+    PORTA_BUF, PORTA_NOT,
+    PORTA_AND, PORTA_NAND,
+    PORTA_OR, PORTA_NOR,
+    PORTA_XOR, PORTA_XNOR
+} TipoPorta;
+
+// Um sinal do circuito: entrada primária ou saída de uma porta
+typedef struct {
+    char *nome;
+    TipoPorta tipo;
+    int *entradas;      // Sinais que alimentam a porta
+    int num_entradas;
+    int var_idx;        // Variável do BDD (só para entradas primárias)
+} Sinal;
+
+// Circuito combinacional lido de um arquivo .bench
+typedef struct {
+    Sinal *sinais;
+    int num_sinais, cap_sinais;
+    int *tabela;        // Nome -> sinal (endereçamento aberto, -1 = vazio)
+    int tam_tabela;
+    int *entradas;      // INPUT(...) na ordem do arquivo
+    int num_entradas;
+    int *saidas;        // OUTPUT(...) na ordem do arquivo
+    int num_saidas;
+} Circuito;
+
+static unsigned circuito_hash(const char *nome)
+{
+    unsigned h = 2166136261u;  // FNV-1a
+    for (; *nome; nome++) h = (h ^ (unsigned char)*nome) * 16777619u;
+    return h;
+}
+
+/**
+ * Assinatura de um circuito para o modelo gravado com --modelo: FNV-1a de 64 bits
+ * dos bytes do arquivo .bench seguidos dos nomes das saídas, na ordem das raízes
+ */
+static uint64_t circuito_assinatura(const char *caminho, const Circuito *c)
+{
+    uint64_t h = 14695981039346656037ull;
+    FILE *arq = fopen(caminho, "rb");
+    if (arq != NULL) {
+        unsigned char bloco[65536];
+        size_t lidos;
+        while ((lidos = fread(bloco, 1, sizeof(bloco), arq)) > 0) {
+            for (size_t k = 0; k < lidos; k++) h = (h ^ bloco[k]) * 1099511628211ull;
+        }
+        fclose(arq);
+    }
+    for (int k = 0; k < c->num_saidas; k++) {
+        for (const char *s = c->sinais[c->saidas[k]].nome; ; s++) {
+            h = (h ^ (unsigned char)*s) * 1099511628211ull;  // O '\0' separa os nomes
+            if (*s == '\0') break;
+        }
+    }
+    return h;
+}
+
+/**
+ * Procura um sinal pelo nome
+ * Retorna: índice do sinal ou -1 se não existe
+ */
+int circuito_procurar(const Circuito *c, const char *nome)
+{
+    unsigned h = circuito_hash(nome) & (c->tam_tabela - 1);
+    while (c->tabela[h] != -1) {
+        if (strcmp(c->sinais[c->tabela[h]].nome, nome) == 0) return c->tabela[h];
+        h = (h + 1) & (c->tam_tabela - 1);
+    }
+    return -1;
+}
+
+/**
+ * Índice do sinal com esse nome, criando-o (ainda indefinido) na primeira vez
+ */
+static int circuito_sinal(Circuito *c, const char *nome)
+{
+    int s = circuito_procurar(c, nome);
+    if (s != -1) return s;
+
+    if (c->num_sinais == c->cap_sinais) {
+        c->cap_sinais *= 2;
+        c->sinais = (Sinal*)realloc(c->sinais, c->cap_sinais * sizeof(Sinal));
+    }
+    s = c->num_sinais++;
+    Sinal *sinal = &c->sinais[s];
+    sinal->nome = (char*)malloc(strlen(nome) + 1);
+    strcpy(sinal->nome, nome);
+    sinal->tipo = PORTA_INDEFINIDA;
+    sinal->entradas = NULL;
+    sinal->num_entradas = 0;
+    sinal->var_idx = -1;
+
+    // Tabela com no máximo metade ocupada
+    if (2 * c->num_sinais > c->tam_tabela) {
+        free(c->tabela);
+        c->tam_tabela *= 2;
+        c->tabela = (int*)malloc(c->tam_tabela * sizeof(int));
+        memset(c->tabela, -1, c->tam_tabela * sizeof(int));
+        for (int k = 0; k < c->num_sinais; k++) {
+            unsigned h = circuito_hash(c->sinais[k].nome) & (c->tam_tabela - 1);
+            while (c->tabela[h] != -1) h = (h + 1) & (c->tam_tabela - 1);
+            c->tabela[h] = k;
+        }
+    }
+    else {
+        unsigned h = circuito_hash(nome) & (c->tam_tabela - 1);
+        while (c->tabela[h] != -1) h = (h + 1) & (c->tam_tabela - 1);
+        c->tabela[h] = s;
+    }
+    return s;
+}
+
+void circuito_liberar(Circuito *c)
+{
+    for (int s = 0; s < c->num_sinais; s++) {
+        free(c->sinais[s].nome);
+        free(c->sinais[s].entradas);
+    }
+    free(c->sinais);
+    free(c->tabela);
+    free(c->entradas);
+    free(c->saidas);
+    free(c);
+}
+
+/**
+ * Tira espaços do início e do fim (no próprio texto)
+ */
+static char *aparar(char *s)
+{
+    while (*s == ' ' || *s == '\t') s++;
+    char *fim = s + strlen(s);
+    while (fim > s && (fim[-1] == ' ' || fim[-1] == '\t' || fim[-1] == '\r' || fim[-1] == '\n')) fim--;
+    *fim = '\0';
+    return s;
+}
+
+/**
+ * Lê um circuito combinacional no formato ISCAS .bench:
+ *     # comentário
+ *     INPUT(G1)
+ *     OUTPUT(G22)
+ *     G10 = NAND(G1, G3)
+ * Os sinais podem ser usados antes de definidos. Flip-flops (DFF) não são aceitos.
+ * Retorna: o circuito, ou NULL (com a mensagem de erro já impressa)
+ */
+Circuito *circuito_ler(const char *caminho)
+{
+    static const struct { const char *nome; TipoPorta tipo; } TIPOS[] = {
+        {"BUF", PORTA_BUF}, {"BUFF", PORTA_BUF}, {"NOT", PORTA_NOT},
+        {"AND", PORTA_AND}, {"NAND", PORTA_NAND}, {"OR", PORTA_OR},
+        {"NOR", PORTA_NOR}, {"XOR", PORTA_XOR}, {"XNOR", PORTA_XNOR}
+    };
+
+    FILE *arq = fopen(caminho, "r");
+    if (arq == NULL) {
+        printf("Erro ao abrir o arquivo %s.\n", caminho);
+        return NULL;
+    }
+
+    Circuito *c = (Circuito*)calloc(1, sizeof(Circuito));
+    c->cap_sinais = 64;
+    c->sinais = (Sinal*)malloc(c->cap_sinais * sizeof(Sinal));
+    c->tam_tabela = 128;
+    c->tabela = (int*)malloc(c->tam_tabela * sizeof(int));
+    memset(c->tabela, -1, c->tam_tabela * sizeof(int));
+
+    char linha_buf[4096];
+    long linha = 0;
+    while (fgets(linha_buf, sizeof(linha_buf), arq) != NULL) {
+        linha++;
+        char *comentario = strchr(linha_buf, '#');
+        if (comentario != NULL) *comentario = '\0';
+        char *texto = aparar(linha_buf);
+        if (*texto == '\0') continue;
+
+        char *abre = strchr(texto, '(');
+        char *fecha = strrchr(texto, ')');
+        if (abre == NULL || fecha == NULL || fecha < abre) {
+            printf("Erro em %s, linha %ld: esperado NOME(...).\n", caminho, linha);
+            circuito_liberar(c);
+            fclose(arq);
+            return NULL;
+        }
+        *fecha = '\0';
+        char *igual = strchr(texto, '=');
+
+        if (igual == NULL) {
+            // INPUT(x) ou OUTPUT(x)
+            *abre = '\0';
+            char *palavra = aparar(texto);
+            int s = circuito_sinal(c, aparar(abre + 1));
+            if (strcmp(palavra, "INPUT") == 0) {
+                if (c->sinais[s].tipo != PORTA_INDEFINIDA) {
+                    printf("Erro em %s, linha %ld: sinal %s definido duas vezes.\n", caminho, linha, c->sinais[s].nome);
+                    circuito_liberar(c);
+                    fclose(arq);
+                    return NULL;
+                }
+                c->sinais[s].tipo = PORTA_ENTRADA;
+                c->entradas = (int*)realloc(c->entradas, (c->num_entradas + 1) * sizeof(int));
+                c->entradas[c->num_entradas++] = s;
+            }
+            else if (strcmp(palavra, "OUTPUT") == 0) {
+                c->saidas = (int*)realloc(c->saidas, (c->num_saidas + 1) * sizeof(int));
+                c->saidas[c->num_saidas++] = s;
+            }
+            else {
+                printf("Erro em %s, linha %ld: declaracao %s desconhecida.\n", caminho, linha, palavra);
+                circuito_liberar(c);
+                fclose(arq);
+                return NULL;
+            }
+            continue;
+        }
+
+        // saida = TIPO(a, b, ...)
+        *igual = '\0';
+        *abre = '\0';
+        int s = circuito_sinal(c, aparar(texto));
+        char *nome_tipo = aparar(igual + 1);
+        TipoPorta tipo = PORTA_INDEFINIDA;
+        for (size_t k = 0; k < sizeof(TIPOS) / sizeof(TIPOS[0]); k++) {
+            if (strcmp(nome_tipo, TIPOS[k].nome) == 0) tipo = TIPOS[k].tipo;
+        }
+        if (tipo == PORTA_INDEFINIDA) {
+            printf("Erro em %s, linha %ld: porta %s nao suportada (so circuitos combinacionais).\n",
+                   caminho, linha, nome_tipo);
+            circuito_liberar(c);
+            fclose(arq);
+            return NULL;
+        }
+        if (c->sinais[s].tipo != PORTA_INDEFINIDA) {
+            printf("Erro em %s, linha %ld: sinal %s definido duas vezes.\n", caminho, linha, c->sinais[s].nome);
+            circuito_liberar(c);
+            fclose(arq);
+            return NULL;
+        }
+
+        int num = 0;
+        int *entradas = NULL;
+        for (char *arg = strtok(abre + 1, ","); arg != NULL; arg = strtok(NULL, ",")) {
+            entradas = (int*)realloc(entradas, (num + 1) * sizeof(int));
+            entradas[num++] = circuito_sinal(c, aparar(arg));
+        }
+        if (num == 0 || ((tipo == PORTA_BUF || tipo == PORTA_NOT) && num != 1)) {
+            printf("Erro em %s, linha %ld: numero de entradas invalido para %s.\n", caminho, linha, nome_tipo);
+            free(entradas);
+            circuito_liberar(c);
+            fclose(arq);
+            return NULL;
+        }
+        c->sinais[s].tipo = tipo;
+        c->sinais[s].entradas = entradas;
+        c->sinais[s].num_entradas = num;
+    }
+    fclose(arq);
+
+    for (int s = 0; s < c->num_sinais; s++) {
+        if (c->sinais[s].tipo == PORTA_INDEFINIDA) {
+            printf("Erro em %s: sinal %s usado mas nunca definido.\n", caminho, c->sinais[s].nome);
+            circuito_liberar(c);
+            return NULL;
+        }
+    }
+    return c;
+}
+
+/**
+ * Ordem topológica das portas que alimentam as saídas (busca em profundidade
+ * iterativa, porque circuitos reais são fundos demais para recursão)
+ * Retorna: número de portas em ordem, ou -1 se o circuito tiver um ciclo
+ */
+static int circuito_ordem_topologica(const Circuito *c, int *ordem)
+{
+    // estado: 0 = não visitado, 1 = na pilha, 2 = pronto
+    char *estado = (char*)calloc(c->num_sinais, sizeof(char));
+    int *pilha = (int*)malloc(c->num_sinais * sizeof(int));
+    int *prox_entrada = (int*)calloc(c->num_sinais, sizeof(int));
+    int tam = 0;
+
+    for (int k = 0; k < c->num_saidas; k++) {
+        if (estado[c->saidas[k]] != 0) continue;
+        int topo = 0;
+        pilha[topo++] = c->saidas[k];
+        estado[c->saidas[k]] = 1;
+        while (topo > 0) {
+            int s = pilha[topo - 1];
+            const Sinal *sinal = &c->sinais[s];
+            if (prox_entrada[s] < sinal->num_entradas) {
+                int e = sinal->entradas[prox_entrada[s]++];
+                if (estado[e] == 1) {
+                    tam = -1;  // Ciclo combinacional
+                    goto fim;
+                }
+                if (estado[e] == 0) {
+                    estado[e] = 1;
+                    pilha[topo++] = e;
+                }
+                continue;
+            }
+            estado[s] = 2;
+            topo--;
+            if (sinal->tipo != PORTA_ENTRADA) ordem[tam++] = s;
+        }
+    }
+
+fim:
+    free(estado);
+    free(pilha);
+    free(prox_entrada);
+    return tam;
+}
+
+/**
+ * Constrói o BDD de cada saída em ordem topológica
+ * Cada porta fica referenciada só até a sua última leitura, então só a "frente"
+ * do circuito ocupa memória. As entradas primárias precisam ter var_idx definido.
+ * Retorna: vetor com o BDD de cada saída (referenciados), ou NULL se houver ciclo
+ */
+BDD *circuito_construir(GerenciadorBDD *ger, const Circuito *c)
+{
+    int *ordem = (int*)malloc(c->num_sinais * sizeof(int));
+    int num_portas = circuito_ordem_topologica(c, ordem);
+    if (num_portas < 0) {
+        free(ordem);
+        return NULL;
+    }
+
+    // Leituras pendentes de cada sinal: entradas de portas e saídas do circuito
+    int *pendentes = (int*)calloc(c->num_sinais, sizeof(int));
+    for (int k = 0; k < num_portas; k++) {
+        const Sinal *porta = &c->sinais[ordem[k]];
+        for (int j = 0; j < porta->num_entradas; j++) pendentes[porta->entradas[j]]++;
+    }
+    for (int k = 0; k < c->num_saidas; k++) pendentes[c->saidas[k]]++;
+
+    BDD *valor = (BDD*)malloc(c->num_sinais * sizeof(BDD));
+    for (int k = 0; k < c->num_entradas; k++) {
+        int s = c->entradas[k];
+        valor[s] = bdd_variavel(ger, c->sinais[s].var_idx);
+        if (pendentes[s] > 0) bdd_ref(ger, valor[s]);  // Entrada que ninguém lê não é referenciada
+    }
+
+    for (int k = 0; k < num_portas; k++) {
+        const Sinal *porta = &c->sinais[ordem[k]];
+        BDD acc = bdd_ref(ger, valor[porta->entradas[0]]);
+        for (int j = 1; j < porta->num_entradas; j++) {
+            BDD e = valor[porta->entradas[j]];
+            BDD novo;
+            switch (porta->tipo) {
+                case PORTA_AND: case PORTA_NAND: novo = bdd_e(ger, acc, e); break;
+                case PORTA_OR: case PORTA_NOR: novo = bdd_ou(ger, acc, e); break;
+                default: novo = bdd_xou(ger, acc, e); break;  // XOR e XNOR
+            }
+            bdd_ref(ger, novo);
+            bdd_deref(ger, acc);
+            acc = novo;
+        }
+        // Negar não cria nós e a referência vale para as duas polaridades
+        if (porta->tipo == PORTA_NOT || porta->tipo == PORTA_NAND ||
+            porta->tipo == PORTA_NOR || porta->tipo == PORTA_XNOR) {
+            acc = bdd_nao(ger, acc);
+        }
+        valor[ordem[k]] = acc;
+
+        // Última leitura de uma entrada: ela já pode ser recolhida
+        for (int j = 0; j < porta->num_entradas; j++) {
+            int e = porta->entradas[j];
+            if (--pendentes[e] == 0) bdd_deref(ger, valor[e]);
+        }
+    }
+
+    BDD *saidas = (BDD*)malloc(c->num_saidas * sizeof(BDD));
+    for (int k = 0; k < c->num_saidas; k++) {
+        int s = c->saidas[k];
+        saidas[k] = bdd_ref(ger, valor[s]);
+        if (--pendentes[s] == 0) bdd_deref(ger, valor[s]);
+    }
+    free(valor);
+    free(pendentes);
+    free(ordem);
+    return saidas;
+}
+
+/**
+ * Verifica a equivalência de dois circuitos .bench, calculando cada operação com
+ * o número de threads dado
+ * Entradas com o mesmo nome viram a mesma variável; saídas são pareadas pelo nome
+ * (ou pela posição, se nenhum nome coincidir). Para cada par, o miter
+ * f XOR g é o BDD constante FALSO exatamente quando f e g são a mesma aresta.
+ * Se algum par diferir, mostra uma atribuição das entradas que separa os circuitos.
+ * modelo: arquivo com os BDDs das saídas do circuito 1 (NULL = sempre construir).
+ * Se existir e tiver sido gravado a partir do mesmo arquivo1 (mesmos bytes e mesmas
+ * saídas), é carregado no lugar da construção; senão o circuito é construído e o
+ * modelo é gravado (ou regravado) depois.
+ * Retorna: 0 se equivalentes, 1 se diferentes, 2 em caso de erro
+ */
+int verificar_netlists(const char *arq1, const char *arq2, int threads, const char *modelo)
+{
+    printf("VERIFICACAO DE EQUIVALENCIA: %s x %s\n", arq1, arq2);
+    printf("=================================\n");
+
+    Circuito *c1 = circuito_ler(arq1);
+    Circuito *c2 = c1 != NULL ? circuito_ler(arq2) : NULL;
+    if (c2 == NULL) {
+        if (c1 != NULL) circuito_liberar(c1);
+        return 2;
+    }
+    printf("%s: %d entradas, %d saidas, %d sinais\n", arq1, c1->num_entradas, c1->num_saidas, c1->num_sinais);
+    printf("%s: %d entradas, %d saidas, %d sinais\n", arq2, c2->num_entradas, c2->num_saidas, c2->num_sinais);
+
+    // Variáveis: as do modelo gravado (na ordem dele), as entradas de c1 na ordem
+    // do arquivo e depois as que só c2 tem
+    GerenciadorBDD *ger = bdd_iniciar();
+    bdd_reordenamento_automatico(ger, 1);
+    bdd_usar_threads(ger, threads);
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    BDD *f1 = NULL;
+    uint64_t assinatura = modelo != NULL ? circuito_assinatura(arq1, c1) : 0;
+    if (modelo != NULL && access(modelo, F_OK) == 0) {
+        int num_raizes;
+        f1 = bdd_carregar(ger, modelo, assinatura, &num_raizes);
+        if (f1 != NULL && num_raizes != c1->num_saidas) {
+            free(f1);
+            f1 = NULL;
+        }
+        if (f1 != NULL) {
+            printf("Modelo de %s carregado de %s em %.3fs (%u nos)\n", arq1, modelo, segundos_desde(&inicio),
+                   ger->vivos);
+        }
+        else {
+            // Modelo de outra versão do circuito (ou estragado): nunca confiar nele.
+            // Recomeça num gerenciador limpo, sem variáveis ou nós que a carga deixou.
+            printf("Modelo %s nao corresponde a %s; o circuito sera construido de novo.\n", modelo, arq1);
+            bdd_liberar(ger);
+            ger = bdd_iniciar();
+            bdd_reordenamento_automatico(ger, 1);
+            bdd_usar_threads(ger, threads);
+        }
+    }
+    int carregado = f1 != NULL;
+    for (int k = 0; k < c1->num_entradas; k++) {
+        Sinal *e = &c1->sinais[c1->entradas[k]];
+        int v = bdd_procurar_var(ger, e->nome);
+        e->var_idx = v != -1 ? v : bdd_nova_var(ger, e->nome);
+    }
+    for (int k = 0; k < c2->num_entradas; k++) {
+        Sinal *e = &c2->sinais[c2->entradas[k]];
+        int s1 = circuito_procurar(c1, e->nome);
+        e->var_idx = (s1 != -1 && c1->sinais[s1].tipo == PORTA_ENTRADA) ? c1->sinais[s1].var_idx
+                                                                        : bdd_nova_var(ger, e->nome);
+    }
+
+    if (!carregado) {
+        f1 = circuito_construir(ger, c1);
+        long tamanho = f1 != NULL && modelo != NULL ? bdd_salvar(ger, modelo, f1, c1->num_saidas, assinatura) : -1;
+        if (tamanho >= 0) printf("Modelo de %s gravado em %s (%ld bytes)\n", arq1, modelo, tamanho);
+    }
+    BDD *f2 = f1 != NULL ? circuito_construir(ger, c2) : NULL;
+    if (f2 == NULL) {
+        printf("Erro: %s tem um ciclo combinacional.\n", f1 == NULL ? arq1 : arq2);
+        free(f1);
+        bdd_liberar(ger);
+        circuito_liberar(c1);
+        circuito_liberar(c2);
+        return 2;
+    }
+
+    // Pareia as saídas
+    int *par = (int*)malloc(c1->num_saidas * sizeof(int));
+    int pareadas = 0;
+    for (int k = 0; k < c1->num_saidas; k++) {
+        par[k] = -1;
+        for (int j = 0; j < c2->num_saidas && par[k] == -1; j++) {
+            if (strcmp(c1->sinais[c1->saidas[k]].nome, c2->sinais[c2->saidas[j]].nome) == 0) par[k] = j;
+        }
+        pareadas += par[k] != -1;
+    }
+    if (pareadas == 0 && c1->num_saidas == c2->num_saidas) {
+        for (int k = 0; k < c1->num_saidas; k++) par[k] = k;
+        pareadas = c1->num_saidas;
+    }
+    if (pareadas == 0) {
+        printf("Erro: os circuitos nao tem saidas em comum.\n");
+        free(par);
+        free(f1);
+        free(f2);
+        bdd_liberar(ger);
+        circuito_liberar(c1);
+        circuito_liberar(c2);
+        return 2;
+    }
+    if (pareadas < c1->num_saidas || pareadas < c2->num_saidas) {
+        printf("Aviso: %d saidas sem par foram ignoradas.\n", c1->num_saidas + c2->num_saidas - 2 * pareadas);
+    }
+
+    int diferentes = 0;
+    int *valores = (int*)calloc(ger->cont_vars, sizeof(int));
+    for (int k = 0; k < c1->num_saidas; k++) {
+        if (par[k] == -1) continue;
+        BDD miter = bdd_xou(ger, f1[k], f2[par[k]]);
+        if (miter == ger->zero) continue;
+
+        if (diferentes++ == 0) {
+            // Contraexemplo: um caminho até 1 no miter (variáveis fora dele ficam em 0)
+            bdd_um_caminho(ger, miter, valores);
+            printf("\nSaida %s difere. Contraexemplo:\n ", c1->sinais[c1->saidas[k]].nome);
+            for (int v = 0; v < ger->cont_vars; v++) printf(" %s=%d", ger->nomes_vars[v], valores[v]);
+            printf("\n  %s: %s = %d\n", arq1, c1->sinais[c1->saidas[k]].nome, bdd_avaliar(ger, f1[k], valores));
+            printf("  %s: %s = %d\n", arq2, c2->sinais[c2->saidas[par[k]]].nome,
+                   bdd_avaliar(ger, f2[par[k]], valores));
+            printf("  %.6g de 2^%d entradas distinguem essa saida\n", bdd_contar(ger, miter), ger->cont_vars);
+        }
+    }
+    double segundos = segundos_desde(&inicio);
+
+    printf("\nResultado: ");
+    if (diferentes == 0) printf("✓ circuitos EQUIVALENTES (%d saidas comparadas)\n", pareadas);
+    else printf("✗ %d de %d saidas DIFERENTES\n", diferentes, pareadas);
+    printf("%.2fs; %u nos vivos (pico %u), %ld coletas, %ld reordenamentos\n",
+           segundos, ger->vivos, ger->pico_vivos, ger->coletas, ger->reordenamentos);
+
+    free(valores);
+    free(par);
+    free(f1);
+    free(f2);
+    bdd_liberar(ger);
+    circuito_liberar(c1);
+    circuito_liberar(c2);
+    return diferentes == 0 ? 0 : 1;
+}
+
+// ==================== PROGRAMA PRINCIPAL ====================
+
+/**
+ * Função principal que testa a equivalência dos dois circuitos
+ * Circuito 1: F1 = (A AND B) OR C
+ * Circuito 2: F2 = (A OR C) AND (B OR C)
+ * Estes circuitos são logicamente equivalentes
+ */
+void testar_circuitos()
+{
+    printf("VERIFICACAO DE CIRCUITOS COM BDD\n");
+    printf("=================================\n\n");
+
+    // Inicializa o sistema BDD
+    GerenciadorBDD *ger = bdd_iniciar();
+
+    // Cria as variáveis booleanas
+    int A = bdd_nova_var(ger, "A");
+    int B = bdd_nova_var(ger, "B");
+    int C = bdd_nova_var(ger, "C");
+
+    // Cria os nós para cada variável
+    BDD varA = bdd_variavel(ger, A);
+    BDD varB = bdd_variavel(ger, B);
+    BDD varC = bdd_variavel(ger, C);
+
+    printf("Circuitos para ComparaCAO:\n");
+    printf("1: F1 = (A E B) OU C\n");
+    printf("2: F2 = (A OU C) E (B OU C)\n\n");
+
+    // Constrói o Circuito 1: F1 = (A AND B) OR C
+    // (resultados guardados entre operações levam bdd_ref, senão o coletor pode levá-los)
+    BDD F1_e = bdd_e(ger, varA, varB);                 // (A AND B)
+    BDD F1 = bdd_ref(ger, bdd_ou(ger, F1_e, varC));    // (A AND B) OR C
+
+    // Constrói o Circuito 2: F2 = (A OR C) AND (B OR C)
+    BDD F2_ou1 = bdd_ref(ger, bdd_ou(ger, varA, varC)); // (A OR C)
+    BDD F2_ou2 = bdd_ou(ger, varB, varC);               // (B OR C)
+    BDD F2 = bdd_ref(ger, bdd_e(ger, F2_ou1, F2_ou2));  // (A OR C) AND (B OR C)
+    bdd_deref(ger, F2_ou1);
+
+    printf("Resultado da Verificacao:\n");
+    if (bdd_sao_equivalentes(F1, F2))
+    {
+        printf("✓ F1 e F2 sao EQUIVALENTES!\n");
+        printf("  Os dois circuitos implementam a mesma funcao logica.\n");
+    }
+    else {
+
+        printf("✗ F1 e F2 nao sao equivalentes!\n");
+    }
+
+    // Entradas que ligam F1, em cubos ('-' = tanto faz)
+    printf("\nF1 vale 1 em %.0f de 8 entradas:\n", bdd_contar(ger, F1));
+    IteradorCubos it;
+    signed char cubo[3];
+    bdd_iterador_iniciar(&it, ger, F1);
+    while (bdd_proximo_cubo(&it, cubo)) {
+        printf(" ");
+        for (int v = 0; v < ger->cont_vars; v++) {
+            printf(" %s=%c", ger->nomes_vars[v], cubo[v] < 0 ? '-' : '0' + cubo[v]);
+        }
+        printf("\n");
+    }
+    bdd_iterador_liberar(&it);
+
+    bdd_liberar(ger);
+}
+
+/**
+ * Confere os operadores derivados do ITE contra as definições com E/OU/NÃO
+ * e compara duas construções da paridade de n bits (em cadeia e em árvore),
+ * um circuito cheio de caminhos que se reencontram
+ */
+void testar_operadores(int n)
+{
+    printf("\nOPERADORES SOBRE O ITE\n");
+    printf("=================================\n");
+
+    GerenciadorBDD *ger = bdd_iniciar();
+    BDD A = bdd_variavel(ger, bdd_nova_var(ger, "A"));
+    BDD B = bdd_variavel(ger, bdd_nova_var(ger, "B"));
+    BDD S = bdd_variavel(ger, bdd_nova_var(ger, "S"));
+
+    BDD t = bdd_ref(ger, bdd_e(ger, A, bdd_nao(ger, B)));
+    BDD xou = bdd_ref(ger, bdd_ou(ger, t, bdd_e(ger, bdd_nao(ger, A), B)));
+    bdd_deref(ger, t);
+    BDD implica = bdd_ref(ger, bdd_ou(ger, bdd_nao(ger, A), B));
+    t = bdd_ref(ger, bdd_e(ger, S, A));
+    BDD mux = bdd_ref(ger, bdd_ou(ger, t, bdd_e(ger, bdd_nao(ger, S), B)));
+    bdd_deref(ger, t);
+    printf("XOR:     %s\n", bdd_sao_equivalentes(bdd_xou(ger, A, B), xou) ? "ok" : "ERRO");
+    printf("IMPLICA: %s\n", bdd_sao_equivalentes(bdd_implica(ger, A, B), implica) ? "ok" : "ERRO");
+    printf("MUX:     %s\n", bdd_sao_equivalentes(bdd_mux(ger, S, A, B), mux) ? "ok" : "ERRO");
+    bdd_liberar(ger);
+
+    // Paridade de n bits: x0 XOR x1 XOR ... em cadeia e em árvore balanceada
+    ger = bdd_iniciar();
+    BDD *x = (BDD*)malloc(n * sizeof(BDD));
+    char nome[20];
+    for (int i = 0; i < n; i++) {
+        sprintf(nome, "x%d", i);
+        x[i] = bdd_ref(ger, bdd_variavel(ger, bdd_nova_var(ger, nome)));
+    }
+    BDD cadeia = bdd_ref(ger, ger->zero);
+    for (int i = 0; i < n; i++) {
+        BDD novo = bdd_ref(ger, bdd_xou(ger, cadeia, x[i]));
+        bdd_deref(ger, cadeia);
+        cadeia = novo;
+    }
+    for (int passo = 1; passo < n; passo *= 2) {   // x[0] acaba com a árvore inteira
+        for (int i = 0; i + passo < n; i += 2 * passo) {
+            BDD novo = bdd_ref(ger, bdd_xou(ger, x[i], x[i + passo]));
+            bdd_deref(ger, x[i]);
+            x[i] = novo;
+        }
+    }
+    printf("Paridade de %d bits (cadeia x arvore): %s; %u nos, %ld de %ld consultas resolvidas pela cache\n",
+           n, bdd_sao_equivalentes(cadeia, x[0]) ? "EQUIVALENTES" : "DIFERENTES",
+           ger->vivos, ger->acertos_cache, ger->consultas_cache);
+    free(x);
+    bdd_liberar(ger);
+}
+
+/**
+ * Cria as variáveis x0 < x1 < ... < x2n-1 e devolve (já referenciada)
+ * F = (x0 E xn) OU (x1 E xn+1) OU ...
+ * Essa ordem é a pior possível para F: o BDD tem cerca de 2^(n+1) nós. Cada passo
+ * descarta o F anterior, então o coletor tem o que recolher no caminho.
+ */
+static BDD construir_escala(GerenciadorBDD *ger, int n)
+{
+    char nome[20];
+    for (int i = 0; i < 2 * n; i++) {
+        sprintf(nome, "x%d", i);
+        bdd_nova_var(ger, nome);
+    }
+    BDD F = bdd_ref(ger, ger->zero);
+    for (int i = 0; i < n; i++) {
+        BDD par = bdd_ref(ger, bdd_e(ger, bdd_variavel(ger, i), bdd_variavel(ger, n + i)));
+        BDD novo = bdd_ref(ger, bdd_ou(ger, F, par));
+        bdd_deref(ger, F);
+        bdd_deref(ger, par);
+        F = novo;
+    }
+    return F;
+}
+
+/**
+ * Teste de escala: constrói a função de construir_escala, que exercita a tabela
+ * única bem além do antigo limite de 10000 nós
+ */
+void testar_escala(int n)
+{
+    printf("\nTESTE DE ESCALA (n = %d)\n", n);
+    printf("=================================\n");
+
+    GerenciadorBDD *ger = bdd_iniciar();
+    clock_t inicio = clock();
+    construir_escala(ger, n);
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+
+    printf("Nos criados: %ld em %.2fs; vivos no fim: %u (pico %u, arena com %u)\n",
+           ger->criados, segundos, ger->vivos, ger->pico_vivos, ger->cap_nos);
+    printf("Coletas de lixo: %ld, %ld nos recolhidos; cache: %ld acertos em %ld consultas\n",
+           ger->coletas, ger->recolhidos, ger->acertos_cache, ger->consultas_cache);
+    bdd_liberar(ger);
+}
+
+/**
+ * Grava a função do teste de escala (ordem ruim, muitos nós) e a carrega num
+ * gerenciador novo, comparando o tempo da carga com o da construção
+ */
+void testar_serializacao(int n)
+{
+    printf("\nSERIALIZACAO (n = %d)\n", n);
+    printf("=================================\n");
+
+    const char *caminho = "escala.bdd";
+    GerenciadorBDD *ger = bdd_iniciar();
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    BDD F = construir_escala(ger, n);
+    double construcao = segundos_desde(&inicio);
+    long tamanho = bdd_salvar(ger, caminho, &F, 1, 0);
+    if (tamanho < 0) {
+        bdd_liberar(ger);
+        return;
+    }
+    uint32_t nos = bdd_tamanho(ger, &F, 1);
+    printf("Construido em %.3fs e gravado em %s: %u nos, %ld bytes (%.1f bytes por no)\n",
+           construcao, caminho, nos, tamanho, (double)tamanho / nos);
+
+    GerenciadorBDD *outro = bdd_iniciar();
+    int num_raizes;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    BDD *lidos = bdd_carregar(outro, caminho, 0, &num_raizes);
+    double carga = segundos_desde(&inicio);
+    remove(caminho);
+    if (lidos != NULL) {
+        printf("Carregado em %.3fs: %u nos, %.0f modelos (original: %.0f)\n",
+               carga, bdd_tamanho(outro, lidos, 1), bdd_contar(outro, lidos[0]), bdd_contar(ger, F));
+        free(lidos);
+    }
+    bdd_liberar(outro);
+    bdd_liberar(ger);
+}
+
+/**
+ * Mesma função do teste de escala, agora com reordenamento: primeiro construída
+ * na ordem ruim e peneirada depois com bdd_reordenar, depois construída com o
+ * reordenamento automático ligado, que a mantém pequena durante toda a construção
+ */
+void testar_reordenamento(int n)
+{
+    printf("\nREORDENAMENTO POR PENEIRAMENTO (n = %d)\n", n);
+    printf("=================================\n");
+
+    for (int automatico = 0; automatico <= 1; automatico++) {
+        GerenciadorBDD *ger = bdd_iniciar();
+        bdd_reordenamento_automatico(ger, automatico);
+        clock_t inicio = clock();
+        construir_escala(ger, n);
+        if (automatico) {
+            printf("Automatico: %u nos vivos no fim (pico %u), %ld reordenamentos, %ld trocas, %.2fs\n",
+                   ger->vivos, ger->pico_vivos, ger->reordenamentos, ger->trocas,
+                   (double)(clock() - inicio) / CLOCKS_PER_SEC);
+        }
+        else {
+            bdd_coletar_lixo(ger, NULL, 0);
+            uint32_t antes = ger->vivos;
+            bdd_reordenar(ger);
+            printf("Explicito: %u nos antes, %u depois de %ld trocas, %.2fs\n",
+                   antes, ger->vivos, ger->trocas, (double)(clock() - inicio) / CLOCKS_PER_SEC);
+        }
+
+        // A nova ordem deve intercalar os pares: x0 x(n) x1 x(n+1) ...
+        printf("Ordem:");
+        for (int nivel = 0; nivel < 2 * n && nivel < 12; nivel++) {
+            printf(" %s", ger->nomes_vars[ger->var_do_nivel[nivel]]);
+        }
+        printf("%s\n", 2 * n > 12 ? " ..." : "");
+        bdd_liberar(ger);
+    }
+}
+
+/**
+ * Alcançabilidade simbólica num contador de n bits que volta a 0 depois de limite
+ * Variáveis intercaladas: x0 x0' x1 x1' ... (estado atual e seguinte)
+ * A relação de transição é T(x, x') = E_i (x'_i <-> prox_i(x)), e a busca em largura
+ * repete R = R OU renomear(existe x. (fronteira E T)) até não haver estado novo.
+ * O resultado tem de ser exatamente x <= limite.
+ */
+void testar_alcancabilidade(int n)
+{
+    GerenciadorBDD *ger = bdd_iniciar();
+    int *atual = (int*)malloc(n * sizeof(int));
+    int *mapa = (int*)malloc(2 * n * sizeof(int));
+    char nome[20];
+    for (int i = 0; i < n; i++) {
+        sprintf(nome, "x%d", i);
+        atual[i] = bdd_nova_var(ger, nome);
+        sprintf(nome, "x%d'", i);
+        int seguinte = bdd_nova_var(ger, nome);
+        mapa[atual[i]] = atual[i];
+        mapa[seguinte] = atual[i];  // x' -> x depois da imagem
+    }
+    unsigned long limite = (1ul << n) - 3;
+    printf("Contador de %d bits ate %lu: ", n, limite);
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // fim = (x == limite); vai-um do incremento começa em 1
+    BDD fim = bdd_ref(ger, ger->um);
+    for (int i = 0; i < n; i++) {
+        BDD x = bdd_variavel(ger, atual[i]);
+        BDD novo = bdd_ref(ger, bdd_e(ger, fim, (limite >> i) & 1 ? x : bdd_nao(ger, x)));
+        bdd_deref(ger, fim);
+        fim = novo;
+    }
+    BDD T = bdd_ref(ger, ger->um);
+    BDD vai_um = bdd_ref(ger, ger->um);
+    for (int i = 0; i < n; i++) {
+        BDD x = bdd_variavel(ger, atual[i]);
+        BDD x_seg = bdd_variavel(ger, atual[i] + 1);
+        BDD soma = bdd_ref(ger, bdd_xou(ger, x, vai_um));
+        BDD prox = bdd_ref(ger, bdd_e(ger, bdd_nao(ger, fim), soma));
+        BDD passo = bdd_ref(ger, bdd_xou(ger, x_seg, bdd_nao(ger, prox)));  // x'_i <-> prox_i
+        BDD novo_T = bdd_ref(ger, bdd_e(ger, T, passo));
+        BDD novo_vai_um = bdd_ref(ger, bdd_e(ger, vai_um, x));
+        bdd_deref(ger, T);
+        bdd_deref(ger, vai_um);
+        bdd_deref(ger, soma);
+        bdd_deref(ger, prox);
+        bdd_deref(ger, passo);
+        T = novo_T;
+        vai_um = novo_vai_um;
+    }
+    bdd_deref(ger, vai_um);
+    bdd_deref(ger, fim);
+    BDD cubo_atual = bdd_ref(ger, bdd_cubo(ger, atual, n));
+
+    // Estado inicial: x = 0
+    BDD R = bdd_ref(ger, ger->um);
+    for (int i = 0; i < n; i++) {
+        BDD novo = bdd_ref(ger, bdd_e(ger, R, bdd_nao(ger, bdd_variavel(ger, atual[i]))));
+        bdd_deref(ger, R);
+        R = novo;
+    }
+    BDD fronteira = bdd_ref(ger, R);
+    long iteracoes = 0;
+    while (fronteira != ger->zero) {
+        BDD imagem_seg = bdd_ref(ger, bdd_e_existe(ger, fronteira, T, cubo_atual));
+        BDD imagem = bdd_ref(ger, bdd_renomear(ger, imagem_seg, mapa));
+        BDD nova = bdd_ref(ger, bdd_e(ger, imagem, bdd_nao(ger, R)));
+        BDD novo_R = bdd_ref(ger, bdd_ou(ger, R, nova));
+        bdd_deref(ger, imagem_seg);
+        bdd_deref(ger, imagem);
+        bdd_deref(ger, fronteira);
+        bdd_deref(ger, R);
+        fronteira = nova;
+        R = novo_R;
+        iteracoes++;
+    }
+    double segundos = segundos_desde(&inicio);
+
+    // Esperado: x <= limite, montado do bit menos significativo para o mais
+    BDD esperado = bdd_ref(ger, ger->um);
+    for (int i = 0; i < n; i++) {
+        BDD nx = bdd_nao(ger, bdd_variavel(ger, atual[i]));
+        BDD novo = bdd_ref(ger, (limite >> i) & 1 ? bdd_ou(ger, nx, esperado) : bdd_e(ger, nx, esperado));
+        bdd_deref(ger, esperado);
+        esperado = novo;
+    }
+    // As variáveis x' ficam livres em R, por isso a contagem é dividida por 2^n
+    printf("%ld iteracoes em %.2fs, %.0f estados, %s\n", iteracoes, segundos, ldexp(bdd_contar(ger, R), -n),
+           bdd_sao_equivalentes(R, esperado) ? "alcancaveis = {x <= limite}" : "ERRO nos estados alcancaveis");
+    free(atual);
+    free(mapa);
+    bdd_liberar(ger);
+}
+
+/**
+ * Curva de aceleração do ITE paralelo: constrói a função do teste de escala na
+ * ordem ruim (muitos nós, recursões largas) com 1, 2, 4, ... threads e compara
+ * o tempo de relógio com o da versão sequencial
+ */
+void testar_paralelo(int n, int max_threads)
+{
+    printf("\nITE PARALELO (n = %d)\n", n);
+    printf("=================================\n");
+    printf("Threads,Tempo,Aceleracao,Nos\n");
+
+    double base = 0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        GerenciadorBDD *ger = bdd_iniciar();
+        bdd_usar_threads(ger, threads);
+        struct timespec inicio;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        construir_escala(ger, n);
+        double segundos = segundos_desde(&inicio);
+        if (threads == 1) base = segundos;
+
+        bdd_coletar_lixo(ger, NULL, 0);
+        printf("%d,%.3f,%.2f,%u\n", threads, segundos, base / segundos, ger->vivos);
+        bdd_liberar(ger);
+    }
+}
+
+/**
+ * Função principal do programa (compilar com -pthread)
+ * Sem argumentos roda as demonstrações; com dois arquivos .bench verifica se
+ * os circuitos são equivalentes (código de saída 0 = equivalentes, 1 = diferentes)
+ *     --threads=N    threads por operação na verificação
+ *     --paralelo=N   só a curva de aceleração do ITE paralelo, de 1 a N threads
+ */
+int main(int argc, char **argv) {
+    int threads = 1, paralelo = 0;
+    const char *modelo = NULL;
+    const char *arquivos[2];
+    int num_arquivos = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--threads=", 10) == 0) threads = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--paralelo=", 11) == 0) paralelo = atoi(argv[i] + 11);
+        else if (strncmp(argv[i], "--modelo=", 9) == 0) modelo = argv[i] + 9;
+        else if (argv[i][0] != '-' && num_arquivos < 2) arquivos[num_arquivos++] = argv[i];
+        else num_arquivos = -1;
+    }
+    if (num_arquivos == 2) return verificar_netlists(arquivos[0], arquivos[1], threads, modelo);
+    if (paralelo > 0 && num_arquivos == 0) {
+        testar_paralelo(20, paralelo);
+        return 0;
+    }
+    if (num_arquivos != 0 || argc != 1) {
+        printf("Uso: %s [--threads=N] [--modelo=saidas1.bdd] [circuito1.bench circuito2.bench] | --paralelo=N\n",
+               argv[0]);
+        return 2;
+    }
     testar_circuitos();
+    testar_operadores(64);
+    testar_escala(18);
+    testar_reordenamento(18);
+    testar_serializacao(18);
+    printf("\nALCANCABILIDADE SIMBOLICA\n");
+    printf("=================================\n");
+    for (int n = 10; n <= 18; n += 4) testar_alcancabilidade(n);
     return 0;
 }